@@ -0,0 +1,120 @@
+#include "arena.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+
+#define ARENA_ALINEACION 16
+
+struct BloqueArena {
+    BloqueArena *siguiente;
+    gsize capacidad;
+    gsize usado;
+};
+
+// Los datos empiezan tras el encabezado, redondeado a la alineación
+#define ARENA_ENCABEZADO ((sizeof(BloqueArena) + ARENA_ALINEACION - 1) & ~(gsize)(ARENA_ALINEACION - 1))
+
+static gsize alinear(gsize tam) {
+    return (tam + ARENA_ALINEACION - 1) & ~(gsize)(ARENA_ALINEACION - 1);
+}
+
+static guchar* datos_bloque(BloqueArena *bloque) {
+    return (guchar*)bloque + ARENA_ENCABEZADO;
+}
+
+static BloqueArena* nuevo_bloque(Arena *arena, gsize minimo) {
+    gsize capacidad = MAX(arena->tam_bloque, minimo);
+    BloqueArena *bloque = g_malloc(ARENA_ENCABEZADO + capacidad);
+    bloque->siguiente = NULL;
+    bloque->capacidad = capacidad;
+    bloque->usado = 0;
+
+    if (arena->ultimo) {
+        arena->ultimo->siguiente = bloque;
+    } else {
+        arena->primero = bloque;
+    }
+    arena->ultimo = bloque;
+
+    // Crecimiento geométrico: pocas llamadas a malloc aunque la solución sea grande
+    arena->tam_bloque *= 2;
+    return bloque;
+}
+
+Arena* arena_nueva(gsize tam_bloque) {
+    Arena *arena = g_new0(Arena, 1);
+    arena->tam_bloque = tam_bloque > 0 ? alinear(tam_bloque) : ARENA_TAM_BLOQUE_DEFECTO;
+    arena->actual = nuevo_bloque(arena, 0);
+    return arena;
+}
+
+void arena_liberar(Arena *arena) {
+    if (!arena) return;
+
+    BloqueArena *bloque = arena->primero;
+    while (bloque) {
+        BloqueArena *siguiente = bloque->siguiente;
+        g_free(bloque);
+        bloque = siguiente;
+    }
+    g_free(arena);
+}
+
+// Deja la arena vacía pero conserva sus bloques para la siguiente resolución
+void arena_reiniciar(Arena *arena) {
+    if (!arena) return;
+
+    for (BloqueArena *bloque = arena->primero; bloque; bloque = bloque->siguiente) {
+        bloque->usado = 0;
+    }
+    arena->actual = arena->primero;
+}
+
+static gpointer reservar(Arena *arena, gsize tam) {
+    tam = alinear(tam > 0 ? tam : 1);
+
+    BloqueArena *bloque = arena->actual;
+    while (bloque && bloque->usado + tam > bloque->capacidad) {
+        bloque = bloque->siguiente;
+    }
+    if (!bloque) {
+        bloque = nuevo_bloque(arena, tam);
+    }
+    arena->actual = bloque;
+
+    gpointer memoria = datos_bloque(bloque) + bloque->usado;
+    bloque->usado += tam;
+    return memoria;
+}
+
+gpointer arena_alloc0(Arena *arena, gsize tam) {
+    gpointer memoria = reservar(arena, tam);
+    memset(memoria, 0, tam);
+    return memoria;
+}
+
+gpointer arena_memdup(Arena *arena, gconstpointer datos, gsize tam) {
+    if (!datos) return NULL;
+    gpointer memoria = reservar(arena, tam);
+    memcpy(memoria, datos, tam);
+    return memoria;
+}
+
+gchar* arena_strdup(Arena *arena, const gchar *texto) {
+    if (!texto) return NULL;
+    return arena_memdup(arena, texto, strlen(texto) + 1);
+}
+
+gchar* arena_strdup_printf(Arena *arena, const gchar *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    int largo = g_vsnprintf(NULL, 0, formato, args);
+    va_end(args);
+    if (largo < 0) return arena_strdup(arena, "");
+
+    gchar *texto = reservar(arena, (gsize)largo + 1);
+    va_start(args, formato);
+    g_vsnprintf(texto, (gulong)largo + 1, formato, args);
+    va_end(args);
+    return texto;
+}
@@ -0,0 +1,34 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+// Bloque de memoria de la arena (los datos van justo después del encabezado)
+typedef struct BloqueArena BloqueArena;
+
+// Arena de asignación lineal: todo lo que se reserva en ella se libera de una sola vez
+typedef struct {
+    BloqueArena *primero;
+    BloqueArena *actual;
+    BloqueArena *ultimo;
+    gsize tam_bloque;
+} Arena;
+
+#define ARENA_TAM_BLOQUE_DEFECTO (16 * 1024)
+
+// Prototipos de funciones
+Arena* arena_nueva(gsize tam_bloque);
+void arena_liberar(Arena *arena);
+void arena_reiniciar(Arena *arena);
+gpointer arena_alloc0(Arena *arena, gsize tam);
+gpointer arena_memdup(Arena *arena, gconstpointer datos, gsize tam);
+gchar* arena_strdup(Arena *arena, const gchar *texto);
+gchar* arena_strdup_printf(Arena *arena, const gchar *formato, ...) G_GNUC_PRINTF(2, 3);
+
+#define arena_new0(arena, tipo, n) ((tipo*) arena_alloc0((arena), sizeof(tipo) * (gsize)(n)))
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,175 @@
+// Microbenchmark de formato.c contra el formateo anterior de latex.c (snprintf).
+// Primero comprueba que ambos producen exactamente el mismo texto y que
+// formato_double_exacto hace ida y vuelta; después mide los dos.
+//
+//     make bench
+#include "formato.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define EPSILON 1.0e-10
+#define NUM_VALORES (1 << 16)
+#define REPETICIONES 40
+
+// ------ Versiones anteriores (copiadas de latex.c) ------
+
+static void formatear_numero_anterior(double valor, char *buffer, size_t buffer_size) {
+    if (fabs(valor - round(valor)) < 0.0001) {
+        snprintf(buffer, buffer_size, "%.0f", valor);
+    } else {
+        snprintf(buffer, buffer_size, "%.4f", valor);
+        for (char *p = buffer; *p; p++) {
+            if (*p == ',') *p = '.';
+        }
+    }
+}
+
+static void formatear_fraccion_anterior(double valor, char *buffer, size_t buffer_size) {
+    double valor_abs = fabs(valor);
+
+    if (fabs(valor_abs - round(valor_abs)) < EPSILON) {
+        snprintf(buffer, buffer_size, "%.0f", valor);
+    } else {
+        int numerador, denominador;
+        int encontrado = 0;
+
+        for (denominador = 2; denominador <= 12; denominador++) {
+            numerador = round(valor_abs * denominador);
+            if (fabs(valor_abs - (double)numerador/denominador) < EPSILON) {
+                if (valor < 0) {
+                    snprintf(buffer, buffer_size, "-\\frac{%d}{%d}", numerador, denominador);
+                } else {
+                    snprintf(buffer, buffer_size, "\\frac{%d}{%d}", numerador, denominador);
+                }
+                encontrado = 1;
+                break;
+            }
+        }
+
+        if (!encontrado) {
+            formatear_numero_anterior(valor, buffer, buffer_size);
+        }
+    }
+}
+
+static void double_exacto_anterior(double valor, char *buffer, size_t buffer_size) {
+    g_ascii_formatd(buffer, buffer_size, "%.17g", valor);
+}
+
+// ------ Valores de prueba: lo que aparece en una tabla simplex ------
+
+static void generar_valores(double *valores, int n) {
+    GRand *rand = g_rand_new_with_seed(12345);
+    for (int i = 0; i < n; i++) {
+        switch (i % 5) {
+            case 0:     // Enteros
+                valores[i] = g_rand_int_range(rand, -1000, 1000);
+                break;
+            case 1:     // Fracciones pequeñas, como quedan tras pivotear
+                valores[i] = (double)g_rand_int_range(rand, -200, 200) / g_rand_int_range(rand, 1, 13);
+                break;
+            case 2:     // Decimales arbitrarios
+                valores[i] = g_rand_double_range(rand, -1e4, 1e4);
+                break;
+            case 3:     // Pocos decimales, como los que escribe el usuario
+                valores[i] = g_rand_int_range(rand, -100000, 100000) / 100.0;
+                break;
+            default:    // Múltiplos de M
+                valores[i] = g_rand_int_range(rand, -5, 5) * 1.0e6 + g_rand_double_range(rand, -10, 10);
+                break;
+        }
+    }
+    g_rand_free(rand);
+}
+
+static int verificar(const double *valores, int n) {
+    static const double especiales[] = { 0.0, -0.0, 0.5, -0.5, 0.00005, -0.00005, 2.00005, 1.23445, 1.23455,
+                                         0.1, 1.0 / 3.0, -2.0 / 7.0, 1e-7, 1e15, 9.1e15, -1e20, 123456789.1234 };
+    int errores = 0;
+    char a[FORMATO_TAM_BUFER], b[FORMATO_TAM_BUFER];
+
+    for (int i = 0; i < n + (int)G_N_ELEMENTS(especiales); i++) {
+        double v = i < n ? valores[i] : especiales[i - n];
+
+        formatear_numero_anterior(v, a, sizeof(a));
+        formato_numero(v, b, sizeof(b));
+        if (strcmp(a, b) != 0 && errores++ < 10) {
+            printf("  numero(%.17g): '%s' != '%s'\n", v, a, b);
+        }
+
+        formatear_fraccion_anterior(v, a, sizeof(a));
+        formato_fraccion_latex(v, EPSILON, b, sizeof(b));
+        if (strcmp(a, b) != 0 && errores++ < 10) {
+            printf("  fraccion(%.17g): '%s' != '%s'\n", v, a, b);
+        }
+
+        formato_double_exacto(v, b, sizeof(b));
+        double leido = g_ascii_strtod(b, NULL);
+        if (memcmp(&leido, &v, sizeof(v)) != 0 && errores++ < 10) {
+            printf("  exacto(%.17g): '%s' no hace ida y vuelta\n", v, b);
+        }
+    }
+    return errores;
+}
+
+typedef void (*FuncionAnterior)(double, char*, size_t);
+typedef gsize (*FuncionNueva)(double, char*, gsize);
+
+static gsize fraccion_nueva(double valor, char *buffer, gsize tam) {
+    return formato_fraccion_latex(valor, EPSILON, buffer, tam);
+}
+
+// Nanosegundos por valor; 'suma' evita que el compilador descarte el trabajo
+static double medir(FuncionAnterior anterior, FuncionNueva nueva, const double *valores, int n, gsize *suma) {
+    char buffer[FORMATO_TAM_BUFER];
+    gint64 inicio = g_get_monotonic_time();
+    for (int r = 0; r < REPETICIONES; r++) {
+        for (int i = 0; i < n; i++) {
+            if (anterior) {
+                anterior(valores[i], buffer, sizeof(buffer));
+            } else {
+                nueva(valores[i], buffer, sizeof(buffer));
+            }
+            *suma += (guchar)buffer[0];
+        }
+    }
+    return (g_get_monotonic_time() - inicio) * 1000.0 / ((double)n * REPETICIONES);
+}
+
+static void comparar(const char *nombre, FuncionAnterior anterior, FuncionNueva nueva,
+                     const double *valores, int n, gsize *suma) {
+    double t_anterior = medir(anterior, NULL, valores, n, suma);
+    double t_nueva = medir(NULL, nueva, valores, n, suma);
+    printf("%-24s %10.1f ns %10.1f ns %8.2fx\n", nombre, t_anterior, t_nueva, t_anterior / t_nueva);
+}
+
+int main(void) {
+    double *valores = g_new(double, NUM_VALORES);
+    generar_valores(valores, NUM_VALORES);
+
+    int errores = verificar(valores, NUM_VALORES);
+    if (errores > 0) {
+        printf("%d diferencias con el formateo anterior\n", errores);
+        g_free(valores);
+        return 1;
+    }
+    printf("Salida idéntica al formateo anterior en %d valores\n\n", NUM_VALORES);
+
+    gsize suma = 0;
+    printf("%-24s %13s %13s %9s\n", "", "anterior", "formato.c", "mejora");
+    comparar("formatear_numero", formatear_numero_anterior, formato_numero, valores, NUM_VALORES, &suma);
+    comparar("formatear_fraccion", formatear_fraccion_anterior, fraccion_nueva, valores, NUM_VALORES, &suma);
+    comparar("double exacto", double_exacto_anterior, formato_double_exacto, valores, NUM_VALORES, &suma);
+
+    // En un CSV los coeficientes son los que escribe el usuario: enteros y pocos decimales
+    int num_usuario = 0;
+    for (int i = 0; i < NUM_VALORES; i++) {
+        if (i % 5 == 0 || i % 5 == 3) valores[num_usuario++] = valores[i];
+    }
+    comparar("double exacto (CSV)", double_exacto_anterior, formato_double_exacto, valores, num_usuario, &suma);
+    printf("\n(control: %zu)\n", suma);
+
+    g_free(valores);
+    return 0;
+}
@@ -0,0 +1,227 @@
+#include "binario.h"
+#include "salida.h"
+#include <string.h>
+
+// ---------------- Escritura ----------------
+
+static void binario_relleno(Salida *salida, gsize bytes) {
+    static const char ceros[8] = { 0 };
+    salida_append_len(salida, ceros, bytes);
+}
+
+// Escribe el modelo en el formato de binario.h; A se guarda en CSR (solo los no ceros)
+gboolean modelo_guardar_binario(const Modelo *modelo, const char *ruta) {
+    int n = modelo->num_vars;
+    int m = modelo->num_rest;
+
+    guint32 no_ceros = 0;
+    for (int r = 0; r < m; r++) {
+        for (int j = 0; j < n; j++) {
+            if (modelo->A[r][j] != 0.0) no_ceros++;
+        }
+    }
+
+    // Bloque de texto: el nombre del problema y luego los de las variables
+    gsize largo_texto = strlen(modelo->nombre) + 1;
+    for (int j = 0; j < n; j++) {
+        largo_texto += strlen(modelo->nombres_vars[j]) + 1;
+    }
+    gsize largo_nombres = (largo_texto + 7) & ~(gsize)7;
+    if (largo_nombres > G_MAXUINT32) return FALSE;
+
+    Salida *salida = salida_archivo(ruta);
+    if (!salida) return FALSE;
+
+    salida_append_len(salida, MODELO_BINARIO_MAGIA, 4);
+    salida_binario_u16(salida, MODELO_BINARIO_VERSION);
+    salida_binario_u16(salida, 0);
+    salida_binario_u32(salida, (guint32)modelo->tipo);
+    salida_binario_u32(salida, (guint32)n);
+    salida_binario_u32(salida, (guint32)m);
+    salida_binario_u32(salida, no_ceros);
+    salida_binario_u32(salida, (guint32)largo_nombres);
+    salida_binario_u32(salida, 0);
+
+    salida_binario_doubles(salida, modelo->c, n);
+    salida_binario_doubles(salida, modelo->lados_derechos, m);
+    for (int r = 0; r < m; r++) {
+        for (int j = 0; j < n; j++) {
+            if (modelo->A[r][j] != 0.0) salida_binario_double(salida, modelo->A[r][j]);
+        }
+    }
+
+    guint32 inicio = 0;
+    salida_binario_u32(salida, 0);
+    for (int r = 0; r < m; r++) {
+        for (int j = 0; j < n; j++) {
+            if (modelo->A[r][j] != 0.0) inicio++;
+        }
+        salida_binario_u32(salida, inicio);
+    }
+    for (int r = 0; r < m; r++) {
+        for (int j = 0; j < n; j++) {
+            if (modelo->A[r][j] != 0.0) salida_binario_u32(salida, (guint32)j);
+        }
+    }
+    for (int r = 0; r < m; r++) {
+        salida_binario_u32(salida, (guint32)modelo->tipos_restricciones[r]);
+    }
+
+    guint32 desplazamiento = 0;
+    salida_binario_u32(salida, desplazamiento);
+    desplazamiento += (guint32)strlen(modelo->nombre) + 1;
+    for (int j = 0; j < n; j++) {
+        salida_binario_u32(salida, desplazamiento);
+        desplazamiento += (guint32)strlen(modelo->nombres_vars[j]) + 1;
+    }
+    guint64 enteros = 2 * (guint64)m + no_ceros + n + 2;
+    if (enteros % 2) binario_relleno(salida, 4);
+
+    salida_append_len(salida, modelo->nombre, strlen(modelo->nombre) + 1);
+    for (int j = 0; j < n; j++) {
+        salida_append_len(salida, modelo->nombres_vars[j], strlen(modelo->nombres_vars[j]) + 1);
+    }
+    binario_relleno(salida, largo_nombres - largo_texto);
+
+    return salida_cerrar(salida);
+}
+
+// ---------------- Lectura ----------------
+
+// Ubica los arreglos de un modelo binario sobre 'datos' sin copiarlos. Devuelve FALSE si
+// el búfer no es un modelo válido (o si el equipo no es little-endian, porque los
+// arreglos se usan tal como están).
+gboolean modelo_binario_vista(gconstpointer datos, gsize largo, VistaModeloBinario *vista) {
+#if G_BYTE_ORDER != G_LITTLE_ENDIAN
+    return FALSE;
+#endif
+    const guint8 *bytes = datos;
+    if (!bytes || largo < sizeof(CabeceraModeloBinario) || ((guintptr)bytes % 8) != 0) return FALSE;
+
+    const CabeceraModeloBinario *cabecera = datos;
+    if (memcmp(cabecera->magia, MODELO_BINARIO_MAGIA, 4) != 0 ||
+        cabecera->version != MODELO_BINARIO_VERSION ||
+        cabecera->tipo > MINIMIZACION || cabecera->num_vars == 0 ||
+        cabecera->num_vars > G_MAXINT || cabecera->num_restricciones > G_MAXINT ||
+        cabecera->largo_nombres == 0 || cabecera->largo_nombres % 8 != 0) {
+        return FALSE;
+    }
+
+    guint64 n = cabecera->num_vars;
+    guint64 m = cabecera->num_restricciones;
+    guint64 nnz = cabecera->no_ceros;
+    guint64 enteros = 2 * m + nnz + n + 2;
+    guint64 esperado = sizeof(CabeceraModeloBinario) + 8 * (n + m + nnz) +
+                       4 * (enteros + enteros % 2) + cabecera->largo_nombres;
+    if (esperado != largo) return FALSE;
+
+    vista->cabecera = cabecera;
+    vista->c = (const double*)(bytes + sizeof(CabeceraModeloBinario));
+    vista->lados_derechos = vista->c + n;
+    vista->valores = vista->lados_derechos + m;
+    vista->inicio_filas = (const guint32*)(vista->valores + nnz);
+    vista->columnas = vista->inicio_filas + m + 1;
+    vista->tipos = vista->columnas + nnz;
+    vista->nombres = vista->tipos + m;
+    vista->texto = (const char*)(vista->nombres + n + 1 + enteros % 2);
+
+    // Índices dentro de rango, para que nadie lea fuera del búfer
+    if (vista->inicio_filas[0] != 0 || vista->inicio_filas[m] != nnz) return FALSE;
+    for (guint64 r = 0; r < m; r++) {
+        if (vista->inicio_filas[r] > vista->inicio_filas[r + 1] || vista->tipos[r] > RESTRICCION_EQ) return FALSE;
+    }
+    for (guint64 k = 0; k < nnz; k++) {
+        if (vista->columnas[k] >= n) return FALSE;
+    }
+    for (guint64 j = 0; j <= n; j++) {
+        if (vista->nombres[j] >= cabecera->largo_nombres) return FALSE;
+    }
+    return vista->texto[cabecera->largo_nombres - 1] == '\0';
+}
+
+// Mapea un archivo .spxm y llena 'vista'. El llamador libera el resultado con
+// g_mapped_file_unref cuando termina de usar la vista.
+GMappedFile* modelo_binario_mapear(const char *ruta, VistaModeloBinario *vista) {
+    GMappedFile *archivo = ruta ? g_mapped_file_new(ruta, FALSE, NULL) : NULL;
+    if (!archivo) return NULL;
+
+    if (!modelo_binario_vista(g_mapped_file_get_contents(archivo), g_mapped_file_get_length(archivo), vista)) {
+        g_mapped_file_unref(archivo);
+        return NULL;
+    }
+    return archivo;
+}
+
+// Nombre del problema (índice -1) o de la variable 'indice'
+const char* modelo_binario_nombre(const VistaModeloBinario *vista, int indice) {
+    return vista->texto + vista->nombres[indice + 1];
+}
+
+// Construye la tabla simplex directamente desde los arreglos de la vista
+TablaSimplex* modelo_binario_a_tabla(const VistaModeloBinario *vista) {
+    int m = (int)vista->cabecera->num_restricciones;
+    TablaSimplex *tabla = crear_tabla_simplex((int)vista->cabecera->num_vars, m,
+                                              (TipoProblema)vista->cabecera->tipo);
+    establecer_funcion_objetivo(tabla, vista->c);
+    for (int r = 0; r < m; r++) {
+        guint32 inicio = vista->inicio_filas[r];
+        agregar_restriccion_dispersa(tabla, r, vista->columnas + inicio, vista->valores + inicio,
+                                     (int)(vista->inicio_filas[r + 1] - inicio),
+                                     vista->lados_derechos[r], (TipoRestriccion)vista->tipos[r]);
+    }
+    return tabla;
+}
+
+// ProblemaInfo que apunta a la vista, sin copiar A: coef_rest y tipos_restricciones
+// quedan en NULL, así que alcanza para serializar el resultado pero no para los reportes.
+// Devuelve el arreglo de nombres de las variables, que el llamador libera con g_free.
+const char** modelo_binario_a_info(const VistaModeloBinario *vista, ProblemaInfo *info) {
+    int n = (int)vista->cabecera->num_vars;
+    const char **nombres = g_new(const char*, n);
+    for (int j = 0; j < n; j++) {
+        nombres[j] = modelo_binario_nombre(vista, j);
+    }
+
+    info->nombre_problema = modelo_binario_nombre(vista, -1);
+    info->tipo_problema = (vista->cabecera->tipo == MAXIMIZACION) ? "MAX" : "MIN";
+    info->num_vars = n;
+    info->num_rest = (int)vista->cabecera->num_restricciones;
+    info->nombres_vars = nombres;
+    info->coef_obj = (double*)vista->c;
+    info->coef_rest = NULL;
+    info->lados_derechos = (double*)vista->lados_derechos;
+    info->tipos_restricciones = NULL;
+    return nombres;
+}
+
+// Copia densa del modelo, para los reportes, las conversiones y la interfaz (que
+// muestra cada coeficiente, así que siempre la necesita)
+Modelo* modelo_binario_a_modelo(const VistaModeloBinario *vista) {
+    int n = (int)vista->cabecera->num_vars;
+    int m = (int)vista->cabecera->num_restricciones;
+    Modelo *modelo = modelo_nuevo(modelo_binario_nombre(vista, -1), (TipoProblema)vista->cabecera->tipo, n, m);
+
+    for (int j = 0; j < n; j++) {
+        modelo_establecer_nombre_variable(modelo, j, modelo_binario_nombre(vista, j));
+    }
+    memcpy(modelo->c, vista->c, n * sizeof(double));
+    memcpy(modelo->lados_derechos, vista->lados_derechos, m * sizeof(double));
+    for (int r = 0; r < m; r++) {
+        modelo->tipos_restricciones[r] = (TipoRestriccion)vista->tipos[r];
+        for (guint32 k = vista->inicio_filas[r]; k < vista->inicio_filas[r + 1]; k++) {
+            modelo->A[r][vista->columnas[k]] = vista->valores[k];
+        }
+    }
+    return modelo;
+}
+
+// Carga un .spxm como Modelo. Devuelve NULL si no existe o no es válido.
+Modelo* modelo_cargar_binario(const char *ruta) {
+    VistaModeloBinario vista;
+    GMappedFile *archivo = modelo_binario_mapear(ruta, &vista);
+    if (!archivo) return NULL;
+
+    Modelo *modelo = modelo_binario_a_modelo(&vista);
+    g_mapped_file_unref(archivo);
+    return modelo;
+}
@@ -0,0 +1,68 @@
+#ifndef BINARIO_H
+#define BINARIO_H
+
+#include <glib.h>
+#include "modelo.h"
+
+G_BEGIN_DECLS
+
+// Formato binario de modelos (.spxm), pensado para mapearse en memoria y usarse sin
+// convertir nada. Todo en little-endian y alineado a 8 bytes:
+//
+//   CabeceraModeloBinario                  32 bytes
+//   double c[n]
+//   double lados_derechos[m]
+//   double valores[no_ceros]               A en CSR, fila por fila
+//   guint32 inicio_filas[m + 1]            La fila r ocupa [inicio_filas[r], inicio_filas[r + 1])
+//   guint32 columnas[no_ceros]             0..n-1
+//   guint32 tipos[m]                       TipoRestriccion
+//   guint32 nombres[n + 1]                 Desplazamientos en el texto: [0] es el nombre
+//                                          del problema y [j + 1] el de la variable j
+//   4 bytes de relleno si hace falta
+//   char texto[largo_nombres]              Cadenas terminadas en '\0', rellenado a 8
+//
+// El tamaño depende solo de la cabecera, así que cada arreglo se ubica sin recorrer el
+// archivo; la validación sí recorre los índices para no leer fuera del búfer.
+#define MODELO_BINARIO_MAGIA "SPXM"
+#define MODELO_BINARIO_VERSION 1
+
+typedef struct {
+    char magia[4];              // "SPXM"
+    guint16 version;
+    guint16 banderas;           // Reservado (0)
+    guint32 tipo;               // TipoProblema
+    guint32 num_vars;           // n
+    guint32 num_restricciones;  // m
+    guint32 no_ceros;
+    guint32 largo_nombres;      // Bytes del bloque de texto (múltiplo de 8)
+    guint32 reservado;
+} CabeceraModeloBinario;
+
+G_STATIC_ASSERT(sizeof(CabeceraModeloBinario) == 32);
+
+// Vista de un modelo binario en memoria: los punteros apuntan dentro del búfer
+typedef struct {
+    const CabeceraModeloBinario *cabecera;
+    const double *c;
+    const double *lados_derechos;
+    const double *valores;
+    const guint32 *inicio_filas;
+    const guint32 *columnas;
+    const guint32 *tipos;
+    const guint32 *nombres;
+    const char *texto;
+} VistaModeloBinario;
+
+// Prototipos de funciones
+gboolean modelo_guardar_binario(const Modelo *modelo, const char *ruta);
+gboolean modelo_binario_vista(gconstpointer datos, gsize largo, VistaModeloBinario *vista);
+GMappedFile* modelo_binario_mapear(const char *ruta, VistaModeloBinario *vista);
+const char* modelo_binario_nombre(const VistaModeloBinario *vista, int indice);
+TablaSimplex* modelo_binario_a_tabla(const VistaModeloBinario *vista);
+const char** modelo_binario_a_info(const VistaModeloBinario *vista, ProblemaInfo *info);
+Modelo* modelo_binario_a_modelo(const VistaModeloBinario *vista);
+Modelo* modelo_cargar_binario(const char *ruta);
+
+G_END_DECLS
+
+#endif
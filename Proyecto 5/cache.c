@@ -0,0 +1,108 @@
+#include "cache.h"
+#include "compilacion.h"
+#include <string.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <glib/gstdio.h>
+
+typedef struct {
+    gchar *ruta;
+    gint64 modificado;      // Nanosegundos, para ordenar bien entradas del mismo segundo
+} EntradaCache;
+
+static gchar* directorio_cache(void) {
+    gchar *directorio = g_build_filename(DIRECTORIO_REPORTES, DIRECTORIO_CACHE, NULL);
+    g_mkdir_with_parents(directorio, 0755);
+    return directorio;
+}
+
+static gchar* ruta_entrada(const char *clave) {
+    gchar *directorio = directorio_cache();
+    gchar *nombre = g_strdup_printf("%s.pdf", clave);
+    gchar *ruta = g_build_filename(directorio, nombre, NULL);
+    g_free(nombre);
+    g_free(directorio);
+    return ruta;
+}
+
+// Copia un archivo completo. g_file_set_contents escribe en un temporal y lo renombra,
+// así que ningún lector (ni otro proceso) ve nunca un archivo a medias.
+static gboolean copiar_archivo(const char *origen, const char *destino) {
+    gchar *contenido = NULL;
+    gsize largo = 0;
+    
+    if (!g_file_get_contents(origen, &contenido, &largo, NULL)) {
+        return FALSE;
+    }
+    gboolean ok = g_file_set_contents(destino, contenido, (gssize)largo, NULL);
+    g_free(contenido);
+    return ok;
+}
+
+// Copia el PDF guardado para 'clave' a 'ruta_destino'. Devuelve FALSE si no está en la caché.
+gboolean cache_reporte_restaurar(const char *clave, const char *ruta_destino) {
+    gchar *ruta = ruta_entrada(clave);
+    
+    // Si otro proceso la desalojó justo ahora, la lectura falla y se trata como fallo de caché
+    gboolean ok = copiar_archivo(ruta, ruta_destino);
+    if (ok) {
+        utime(ruta, NULL);  // Marca la entrada como usada recientemente
+    }
+    g_free(ruta);
+    return ok;
+}
+
+static gint comparar_por_antiguedad(gconstpointer a, gconstpointer b) {
+    const EntradaCache *ea = a;
+    const EntradaCache *eb = b;
+    return (ea->modificado > eb->modificado) - (ea->modificado < eb->modificado);
+}
+
+// Deja como máximo MAX_ENTRADAS_CACHE entradas, borrando las menos usadas
+static void desalojar_entradas(const char *directorio) {
+    GDir *dir = g_dir_open(directorio, 0, NULL);
+    if (!dir) return;
+    
+    GArray *entradas = g_array_new(FALSE, FALSE, sizeof(EntradaCache));
+    const gchar *nombre;
+    while ((nombre = g_dir_read_name(dir)) != NULL) {
+        if (!g_str_has_suffix(nombre, ".pdf")) continue;
+        
+        EntradaCache entrada;
+        struct stat info;
+        entrada.ruta = g_build_filename(directorio, nombre, NULL);
+        if (stat(entrada.ruta, &info) != 0) {
+            g_free(entrada.ruta);
+            continue;
+        }
+        entrada.modificado = (gint64)info.st_mtim.tv_sec * G_GINT64_CONSTANT(1000000000) + info.st_mtim.tv_nsec;
+        g_array_append_val(entradas, entrada);
+    }
+    g_dir_close(dir);
+    
+    if (entradas->len > MAX_ENTRADAS_CACHE) {
+        g_array_sort(entradas, comparar_por_antiguedad);
+        for (guint i = 0; i < entradas->len - MAX_ENTRADAS_CACHE; i++) {
+            g_unlink(g_array_index(entradas, EntradaCache, i).ruta);
+        }
+    }
+    
+    for (guint i = 0; i < entradas->len; i++) {
+        g_free(g_array_index(entradas, EntradaCache, i).ruta);
+    }
+    g_array_free(entradas, TRUE);
+}
+
+// Guarda una copia del PDF compilado bajo 'clave'
+gboolean cache_reporte_guardar(const char *clave, const char *ruta_pdf) {
+    gchar *ruta = ruta_entrada(clave);
+    gboolean ok = copiar_archivo(ruta_pdf, ruta);
+    g_free(ruta);
+    
+    if (ok) {
+        gchar *directorio = directorio_cache();
+        desalojar_entradas(directorio);
+        g_free(directorio);
+    }
+    return ok;
+}
@@ -0,0 +1,18 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+// Caché de reportes ya compilados, indexada por el hash del modelo
+#define DIRECTORIO_CACHE ".cache"
+#define MAX_ENTRADAS_CACHE 64
+
+// Prototipos de funciones
+gboolean cache_reporte_restaurar(const char *clave, const char *ruta_destino);
+gboolean cache_reporte_guardar(const char *clave, const char *ruta_pdf);
+
+G_END_DECLS
+
+#endif
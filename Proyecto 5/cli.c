@@ -0,0 +1,211 @@
+// Versión de línea de comandos: resuelve un problema guardado por la interfaz (CSV)
+// o un archivo MPS, LP o binario (.spxm) y escribe el reporte en PDF, LaTeX, HTML o Markdown, el resultado en JSON o
+// binario, o ambos. Solo depende de libsimplex.
+//
+//     ./simplex_cli -f html Problemas/Ejemplo.csv
+//     ./simplex_cli -f pdf -t -o Reportes/Ejemplo.tex Problemas/Ejemplo.csv
+//     ./simplex_cli -j resultado.json -p Problemas/Ejemplo.csv
+//     ./simplex_cli --fijo -f md modelos/afiro.mps
+//     ./simplex_cli -j resultado.json modelos/plan.lp
+//     ./simplex_cli --spxm modelos/plan.spxm -j resultado.json modelos/plan.lp
+#include <stdio.h>
+#include <string.h>
+#include "modelo.h"
+#include "csv.h"
+#include "mps.h"
+#include "binario.h"
+#include "reporte.h"
+#include "serializacion.h"
+#include "compilacion.h"
+
+static gchar *formato_texto = NULL;
+static gchar *ruta_salida = NULL;
+static gboolean mostrar_tablas = FALSE;
+static gboolean reporte_completo = FALSE;
+static gint iteraciones_completas = REPORTE_ITERACIONES_COMPLETAS;
+static gint max_columnas = REPORTE_MAX_COLUMNAS;
+static gchar *ruta_json = NULL;
+static gchar *ruta_binario = NULL;
+static gboolean incluir_pivotes = FALSE;
+static gboolean mps_fijo = FALSE;
+static gchar *ruta_mps = NULL;
+static gchar *ruta_csv = NULL;
+static gchar *ruta_spxm = NULL;
+
+static GOptionEntry opciones_cli[] = {
+    { "formato", 'f', 0, G_OPTION_ARG_STRING, &formato_texto, "Formato del reporte: pdf, tex, html o md (html por defecto)", "FORMATO" },
+    { "salida", 'o', 0, G_OPTION_ARG_FILENAME, &ruta_salida, "Archivo del reporte (por defecto, el CSV con otra extensión)", "RUTA" },
+    { "tablas", 't', 0, G_OPTION_ARG_NONE, &mostrar_tablas, "Incluir las tablas de todas las iteraciones", NULL },
+    { "completo", 'c', 0, G_OPTION_ARG_NONE, &reporte_completo, "No resumir el reporte en problemas grandes", NULL },
+    { "iteraciones", 0, 0, G_OPTION_ARG_INT, &iteraciones_completas, "Iteraciones con tabla completa al principio y al final (3 por defecto, 0 = todas)", "K" },
+    { "columnas", 0, 0, G_OPTION_ARG_INT, &max_columnas, "Con más variables, las tablas muestran solo las básicas y la que entra (12 por defecto, 0 = todas)", "C" },
+    { "json", 'j', 0, G_OPTION_ARG_FILENAME, &ruta_json, "Escribir el resultado en JSON", "RUTA" },
+    { "binario", 'b', 0, G_OPTION_ARG_FILENAME, &ruta_binario, "Escribir el resultado en binario (little-endian)", "RUTA" },
+    { "pivotes", 'p', 0, G_OPTION_ARG_NONE, &incluir_pivotes, "Incluir el registro de pivotes en el JSON y el binario", NULL },
+    { "fijo", 0, 0, G_OPTION_ARG_NONE, &mps_fijo, "Leer el MPS en formato fijo (por columnas)", NULL },
+    { "mps", 0, 0, G_OPTION_ARG_FILENAME, &ruta_mps, "Guardar el modelo leído en formato MPS", "RUTA" },
+    { "csv", 0, 0, G_OPTION_ARG_FILENAME, &ruta_csv, "Guardar el modelo leído en el CSV de la interfaz", "RUTA" },
+    { "spxm", 0, 0, G_OPTION_ARG_FILENAME, &ruta_spxm, "Guardar el modelo leído en binario (.spxm)", "RUTA" },
+    { NULL }
+};
+
+static const char* describir_solucion(TipoSolucion tipo) {
+    switch (tipo) {
+        case SOLUCION_OPTIMA:      return "óptima";
+        case SOLUCION_MULTIPLE:    return "múltiple";
+        case SOLUCION_NO_ACOTADA:  return "no acotada";
+        case SOLUCION_NO_FACTIBLE: return "no factible";
+        default:                   return "interrumpida";
+    }
+}
+
+// Cambia la extensión de 'ruta' (si tiene) por 'extension'
+static gchar* ruta_con_extension(const char *ruta, const char *extension) {
+    const char *barra = strrchr(ruta, G_DIR_SEPARATOR);
+    const char *punto = strrchr(ruta, '.');
+    gsize largo = (punto && (!barra || punto > barra)) ? (gsize)(punto - ruta) : strlen(ruta);
+    return g_strdup_printf("%.*s.%s", (int)largo, ruta, extension);
+}
+
+int main(int argc, char *argv[]) {
+    GOptionContext *contexto = g_option_context_new("PROBLEMA.csv|.mps|.lp|.spxm");
+    GError *error = NULL;
+    int estado = 1;
+
+    g_option_context_set_summary(contexto, "Resuelve un problema con el método simplex y genera su reporte.");
+    g_option_context_add_main_entries(contexto, opciones_cli, NULL);
+    if (!g_option_context_parse(contexto, &argc, &argv, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(contexto);
+        return 1;
+    }
+    if (argc != 2) {
+        gchar *ayuda = g_option_context_get_help(contexto, TRUE, NULL);
+        g_printerr("%s", ayuda);
+        g_free(ayuda);
+        g_option_context_free(contexto);
+        return 1;
+    }
+    g_option_context_free(contexto);
+
+    // "tex" escribe la fuente LaTeX sin compilarla. Si solo se pide JSON o binario,
+    // no se genera ningún reporte.
+    FormatoReporte formato = REPORTE_HTML;
+    gboolean compilar = TRUE;
+    gboolean con_reporte = formato_texto || (!ruta_json && !ruta_binario);
+    if (formato_texto && g_ascii_strcasecmp(formato_texto, "tex") == 0) {
+        formato = REPORTE_PDF;
+        compilar = FALSE;
+    } else if (formato_texto && !formato_reporte_desde_texto(formato_texto, &formato)) {
+        g_printerr("Formato desconocido: %s\n", formato_texto);
+        return 1;
+    }
+
+    // Un .spxm se mapea y la tabla sale directo de sus arreglos. La copia densa del
+    // modelo solo se arma si hay reporte o conversión; el JSON y el binario se
+    // escriben con la información que apunta a la vista.
+    VistaModeloBinario vista;
+    GMappedFile *mapeado = NULL;
+    Modelo *modelo = NULL;
+    ProblemaInfo info;
+    const char **nombres_vista = NULL;
+    gint64 inicio_carga = g_get_monotonic_time();
+    if (g_str_has_suffix(argv[1], ".spxm")) {
+        mapeado = modelo_binario_mapear(argv[1], &vista);
+    } else {
+        modelo = modelo_cargar_archivo(argv[1], mps_fijo);
+    }
+    if (!modelo && !mapeado) {
+        g_printerr("No se pudo cargar el archivo: %s\n", argv[1]);
+        return 1;
+    }
+    if (mapeado && (con_reporte || ruta_mps || ruta_csv || ruta_spxm)) {
+        modelo = modelo_binario_a_modelo(&vista);
+    }
+    if (modelo) {
+        modelo_a_info(modelo, &info);
+    } else {
+        nombres_vista = modelo_binario_a_info(&vista, &info);
+    }
+    gint64 cargado = g_get_monotonic_time();
+
+    if ((ruta_mps && !modelo_guardar_mps(modelo, ruta_mps)) ||
+        (ruta_csv && !modelo_guardar_csv(modelo, ruta_csv)) ||
+        (ruta_spxm && !modelo_guardar_binario(modelo, ruta_spxm))) {
+        g_printerr("No se pudo guardar el modelo\n");
+        g_free(nombres_vista);
+        modelo_liberar(modelo);
+        if (mapeado) g_mapped_file_unref(mapeado);
+        return 1;
+    }
+    if (info.num_rest <= 0) {
+        g_printerr("El problema no tiene restricciones\n");
+        g_free(nombres_vista);
+        modelo_liberar(modelo);
+        if (mapeado) g_mapped_file_unref(mapeado);
+        return 1;
+    }
+
+    // El PDF sale de compilar el .tex, que queda junto a él
+    const char *extension = formato == REPORTE_PDF ? "tex" : extension_reporte(formato);
+    gchar *ruta = ruta_salida ? g_strdup(ruta_salida) : ruta_con_extension(argv[1], extension);
+
+    gint64 inicio = g_get_monotonic_time();
+    TablaSimplex *tabla = mapeado ? modelo_binario_a_tabla(&vista) : modelo_a_tabla(modelo);
+    ResultadoSimplex *resultado = ejecutar_simplex_completo(tabla, mostrar_tablas);
+    liberar_tabla_simplex(tabla);
+    gint64 resuelto = g_get_monotonic_time();
+
+    OpcionesReporte opciones = { MAX(iteraciones_completas, 0), MAX(max_columnas, 0) };
+    gboolean escrito = TRUE;
+    if (ruta_json) {
+        escrito = resultado_guardar_json(ruta_json, resultado, &info, incluir_pivotes) && escrito;
+    }
+    if (ruta_binario) {
+        escrito = resultado_guardar_binario(ruta_binario, resultado, &info, incluir_pivotes) && escrito;
+    }
+    if (con_reporte) {
+        escrito = generar_reporte(formato, resultado, &info, ruta, mostrar_tablas,
+                                  reporte_completo ? NULL : &opciones) && escrito;
+    }
+    gint64 generado = g_get_monotonic_time();
+
+    printf("Solución: %s\n", describir_solucion(resultado->tipo_solucion));
+    if (resultado->tipo_solucion == SOLUCION_OPTIMA || resultado->tipo_solucion == SOLUCION_MULTIPLE) {
+        printf("Z = %.6g\n", resultado->valor_z);
+    }
+    printf("Iteraciones: %d\n", resultado->iteraciones);
+    printf("Carga del modelo: %" G_GINT64_FORMAT " µs\n", cargado - inicio_carga);
+    printf("Tiempo: %.3f ms resolviendo, %.3f ms escribiendo la salida\n",
+           (resuelto - inicio) / 1000.0, (generado - resuelto) / 1000.0);
+
+    if (escrito && con_reporte && formato == REPORTE_PDF && compilar) {
+        // Igual que en la interfaz, un PDF con errores de LaTeX se entrega con una advertencia
+        if (compilar_latex(ruta) != COMPILACION_FALLIDA) {
+            gchar *pdf = ruta_con_extension(ruta, "pdf");
+            printf("Reporte: %s (%.3f ms compilando)\n", pdf, (g_get_monotonic_time() - generado) / 1000.0);
+            g_free(pdf);
+            estado = 0;
+        } else {
+            g_printerr("Error al compilar %s con pdflatex\n", ruta);
+        }
+    } else if (escrito) {
+        if (con_reporte) printf("Reporte: %s\n", ruta);
+        estado = 0;
+    }
+
+    g_free(ruta);
+    liberar_resultado(resultado);
+    g_free(nombres_vista);
+    modelo_liberar(modelo);
+    if (mapeado) g_mapped_file_unref(mapeado);
+    g_free(formato_texto);
+    g_free(ruta_salida);
+    g_free(ruta_json);
+    g_free(ruta_binario);
+    g_free(ruta_mps);
+    g_free(ruta_csv);
+    g_free(ruta_spxm);
+    return estado;
+}
@@ -0,0 +1,450 @@
+#include "compilacion.h"
+#include "latex.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <glib/gstdio.h>
+
+#define MAX_PASADAS_PDFLATEX 2
+#define PREFIJO_FORMATO "simplex-preambulo-"
+#define MARCA_FIN_PREAMBULO "\\csname endofdump\\endcsname"
+#define TAM_BLOQUE_ANALISIS (64 * 1024)
+
+// Se pone en 1 si no se pudo construir el formato (p. ej. falta mylatexformat)
+static gint formato_no_disponible = 0;
+static gint contador_formatos = 0;
+
+struct CompilacionLatex {
+    gchar *directorio;
+    gchar *nombre_tex;      // Relativo a 'directorio'
+    gchar *nombre_base;     // Sin la extensión .tex
+    gchar *ruta_pdf;
+    int pasada;
+    GPid pid;
+    gboolean cancelada;
+    gboolean hubo_errores;
+    gboolean usa_referencias;   // El documento tiene índice o referencias cruzadas
+    gchar *formato;             // Formato precompilado del preámbulo, o NULL
+    gchar *formato_temporal;    // Nombre con el que se está construyendo el formato
+    gchar *aux_previo;          // Contenido de .aux y .toc antes de la pasada actual
+    gchar *toc_previo;
+    GMainContext *contexto;
+    CompilacionTerminadaFunc funcion;
+    gpointer datos;
+};
+
+static void iniciar_pasada(CompilacionLatex *compilacion);
+
+// Devuelve la ruta del archivo dentro de la carpeta de reportes, creándola si hace falta
+gchar* ruta_reporte(const char *nombre_archivo) {
+    g_mkdir_with_parents(DIRECTORIO_REPORTES, 0755);
+    return g_build_filename(DIRECTORIO_REPORTES, nombre_archivo, NULL);
+}
+
+static gchar* ruta_auxiliar(CompilacionLatex *compilacion, const char *extension) {
+    gchar *nombre = g_strdup_printf("%s.%s", compilacion->nombre_base, extension);
+    gchar *ruta = g_build_filename(compilacion->directorio, nombre, NULL);
+    g_free(nombre);
+    return ruta;
+}
+
+// Contenido del archivo auxiliar, o NULL si no existe
+static gchar* leer_auxiliar(CompilacionLatex *compilacion, const char *extension) {
+    gchar *ruta = ruta_auxiliar(compilacion, extension);
+    gchar *contenido = NULL;
+    g_file_get_contents(ruta, &contenido, NULL, NULL);
+    g_free(ruta);
+    return contenido;
+}
+
+// Borra los archivos auxiliares de pdflatex. El .aux y el .toc se conservan para que
+// la próxima compilación del mismo problema normalmente necesite una sola pasada, y
+// el .log cuando hubo errores, para poder revisarlos.
+static void limpiar_auxiliares(CompilacionLatex *compilacion) {
+    const char *extensiones[] = { "out", "log" };
+    gsize cantidad = compilacion->hubo_errores ? 1 : G_N_ELEMENTS(extensiones);
+    
+    for (gsize i = 0; i < cantidad; i++) {
+        gchar *ruta = ruta_auxiliar(compilacion, extensiones[i]);
+        g_unlink(ruta);
+        g_free(ruta);
+    }
+}
+
+// Nombre del formato para el preámbulo actual; cambia si cambia el preámbulo
+static gchar* nombre_formato(void) {
+    gchar *hash = g_compute_checksum_for_string(G_CHECKSUM_SHA256, preambulo_latex(), -1);
+    gchar *nombre = g_strdup_printf(PREFIJO_FORMATO "%.16s", hash);
+    g_free(hash);
+    return nombre;
+}
+
+// Revisa si el documento usa algo que se resuelve en una segunda pasada y si
+// empieza con el preámbulo fijo de los reportes (entonces puede usar el formato).
+// Se lee por bloques y se corta en la primera coincidencia: los reportes tienen el
+// \tableofcontents al principio, así que en la práctica se lee solo el primer bloque.
+static void analizar_documento(CompilacionLatex *compilacion, const char *ruta_tex) {
+    const char *comandos[] = { "\\tableofcontents", "\\listoftables", "\\listoffigures",
+                               "\\ref{", "\\pageref{", "\\eqref{", "\\cite{" };
+    FILE *archivo = g_fopen(ruta_tex, "rb");
+    if (!archivo) {
+        compilacion->usa_referencias = TRUE;
+        return;
+    }
+    
+    // Cada bloque empieza con la cola del anterior, por si un comando quedó partido
+    gsize solape = 0;
+    for (gsize i = 0; i < G_N_ELEMENTS(comandos); i++) {
+        solape = MAX(solape, strlen(comandos[i]) - 1);
+    }
+    gchar *bloque = g_malloc(solape + TAM_BLOQUE_ANALISIS + 1);
+    gsize arrastre = 0;
+    gboolean primer_bloque = TRUE;
+    gsize leidos;
+    
+    while (!compilacion->usa_referencias &&
+           (leidos = fread(bloque + arrastre, 1, TAM_BLOQUE_ANALISIS, archivo)) > 0) {
+        gsize largo = arrastre + leidos;
+        bloque[largo] = '\0';
+        
+        // El preámbulo de los reportes mide unos pocos KB: entra en el primer bloque
+        if (primer_bloque) {
+            const char *preambulo = preambulo_latex();
+            if (!g_atomic_int_get(&formato_no_disponible) && g_str_has_prefix(bloque, preambulo) &&
+                g_str_has_prefix(bloque + strlen(preambulo), MARCA_FIN_PREAMBULO)) {
+                compilacion->formato = nombre_formato();
+            }
+            primer_bloque = FALSE;
+        }
+        
+        for (gsize i = 0; i < G_N_ELEMENTS(comandos) && !compilacion->usa_referencias; i++) {
+            compilacion->usa_referencias = strstr(bloque, comandos[i]) != NULL;
+        }
+        
+        arrastre = MIN(solape, largo);
+        memmove(bloque, bloque + largo - arrastre, arrastre);
+    }
+    
+    g_free(bloque);
+    fclose(archivo);
+}
+
+// Hace falta otra pasada si cambiaron el .aux o el .toc que leyó la pasada anterior
+static gboolean necesita_otra_pasada(CompilacionLatex *compilacion) {
+    if (!compilacion->usa_referencias || compilacion->pasada >= MAX_PASADAS_PDFLATEX) {
+        return FALSE;
+    }
+    
+    gchar *aux = leer_auxiliar(compilacion, "aux");
+    gchar *toc = leer_auxiliar(compilacion, "toc");
+    gboolean cambio = g_strcmp0(aux, compilacion->aux_previo) != 0 ||
+                      g_strcmp0(toc, compilacion->toc_previo) != 0;
+    
+    g_free(compilacion->aux_previo);
+    g_free(compilacion->toc_previo);
+    compilacion->aux_previo = aux;
+    compilacion->toc_previo = toc;
+    return cambio;
+}
+
+static gboolean terminar_compilacion(gpointer datos) {
+    CompilacionLatex *compilacion = datos;
+    
+    limpiar_auxiliares(compilacion);
+    
+    // El PDF anterior se borró al empezar, así que si existe lo generó esta compilación
+    EstadoCompilacion estado = COMPILACION_FALLIDA;
+    if (!compilacion->cancelada && g_file_test(compilacion->ruta_pdf, G_FILE_TEST_EXISTS)) {
+        estado = compilacion->hubo_errores ? COMPILACION_CON_ERRORES : COMPILACION_CORRECTA;
+    }
+    if (estado == COMPILACION_CON_ERRORES) {
+        g_printerr("Advertencia: pdflatex informó errores; %s puede estar incompleto (ver %s.log)\n",
+                   compilacion->ruta_pdf, compilacion->nombre_base);
+    }
+    
+    if (compilacion->funcion) {
+        compilacion->funcion(compilacion->ruta_pdf, estado, compilacion->datos);
+    }
+    
+    g_main_context_unref(compilacion->contexto);
+    g_free(compilacion->directorio);
+    g_free(compilacion->nombre_tex);
+    g_free(compilacion->nombre_base);
+    g_free(compilacion->ruta_pdf);
+    g_free(compilacion->aux_previo);
+    g_free(compilacion->toc_previo);
+    g_free(compilacion->formato);
+    g_free(compilacion->formato_temporal);
+    g_free(compilacion);
+    return G_SOURCE_REMOVE;
+}
+
+// Programa el cierre en el contexto de la compilación (el aviso nunca es síncrono)
+static void programar_fin(CompilacionLatex *compilacion) {
+    GSource *fuente = g_idle_source_new();
+    g_source_set_callback(fuente, terminar_compilacion, compilacion, NULL);
+    g_source_attach(fuente, compilacion->contexto);
+    g_source_unref(fuente);
+}
+
+static void vigilar_proceso(CompilacionLatex *compilacion, GChildWatchFunc funcion) {
+    GSource *fuente = g_child_watch_source_new(compilacion->pid);
+    g_source_set_callback(fuente, (GSourceFunc)(void (*)(void))funcion, compilacion, NULL);
+    g_source_attach(fuente, compilacion->contexto);
+    g_source_unref(fuente);
+}
+
+static void pasada_terminada(GPid pid, gint estado, gpointer datos) {
+    CompilacionLatex *compilacion = datos;
+    g_spawn_close_pid(pid);
+    compilacion->pid = 0;
+    
+    if (!WIFEXITED(estado) || WEXITSTATUS(estado) != 0) {
+        compilacion->hubo_errores = TRUE;
+    }
+    
+    if (!compilacion->cancelada && necesita_otra_pasada(compilacion)) {
+        iniciar_pasada(compilacion);
+    } else {
+        programar_fin(compilacion);
+    }
+}
+
+// Lanza pdflatex directamente (sin shell) dentro de la carpeta del reporte
+static void iniciar_pasada(CompilacionLatex *compilacion) {
+    gchar *opcion_formato = compilacion->formato ? g_strdup_printf("-fmt=%s", compilacion->formato) : NULL;
+    gchar *argv[] = { "pdflatex", "-interaction=nonstopmode", compilacion->nombre_tex, NULL, NULL };
+    if (opcion_formato) {
+        argv[2] = opcion_formato;
+        argv[3] = compilacion->nombre_tex;
+    }
+    GError *error = NULL;
+    
+    compilacion->pasada++;
+    if (!g_spawn_async(compilacion->directorio, argv, NULL,
+                       G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD |
+                       G_SPAWN_STDOUT_TO_DEV_NULL | G_SPAWN_STDERR_TO_DEV_NULL,
+                       NULL, NULL, &compilacion->pid, &error)) {
+        g_free(opcion_formato);
+        g_printerr("Error: No se pudo ejecutar pdflatex: %s\n", error->message);
+        g_error_free(error);
+        compilacion->hubo_errores = TRUE;
+        programar_fin(compilacion);
+        return;
+    }
+    
+    g_free(opcion_formato);
+    vigilar_proceso(compilacion, pasada_terminada);
+}
+
+// Borra los formatos de preámbulos anteriores
+static void borrar_formatos_viejos(CompilacionLatex *compilacion) {
+    GDir *dir = g_dir_open(compilacion->directorio, 0, NULL);
+    if (!dir) return;
+    
+    gchar *actual = g_strdup_printf("%s.fmt", compilacion->formato);
+    const gchar *nombre;
+    while ((nombre = g_dir_read_name(dir)) != NULL) {
+        if (g_str_has_prefix(nombre, PREFIJO_FORMATO) && g_str_has_suffix(nombre, ".fmt") &&
+            strcmp(nombre, actual) != 0) {
+            gchar *ruta = g_build_filename(compilacion->directorio, nombre, NULL);
+            g_unlink(ruta);
+            g_free(ruta);
+        }
+    }
+    g_free(actual);
+    g_dir_close(dir);
+}
+
+// Borra los archivos que deja la construcción del formato (salvo el .fmt)
+static void limpiar_construccion_formato(CompilacionLatex *compilacion) {
+    const char *extensiones[] = { "tex", "log", "fmt" };
+    
+    for (gsize i = 0; i < G_N_ELEMENTS(extensiones); i++) {
+        gchar *nombre = g_strdup_printf("%s.%s", compilacion->formato_temporal, extensiones[i]);
+        gchar *ruta = g_build_filename(compilacion->directorio, nombre, NULL);
+        g_unlink(ruta);
+        g_free(ruta);
+        g_free(nombre);
+    }
+}
+
+static void formato_construido(GPid pid, gint estado, gpointer datos) {
+    CompilacionLatex *compilacion = datos;
+    g_spawn_close_pid(pid);
+    compilacion->pid = 0;
+    
+    gchar *nombre_temporal = g_strdup_printf("%s.fmt", compilacion->formato_temporal);
+    gchar *nombre_final = g_strdup_printf("%s.fmt", compilacion->formato);
+    gchar *ruta_temporal = g_build_filename(compilacion->directorio, nombre_temporal, NULL);
+    gchar *ruta_final = g_build_filename(compilacion->directorio, nombre_final, NULL);
+    
+    // El formato se construye con otro nombre y se renombra, así otra compilación
+    // concurrente nunca carga un formato a medio escribir
+    if (WIFEXITED(estado) && WEXITSTATUS(estado) == 0 && g_rename(ruta_temporal, ruta_final) == 0) {
+        borrar_formatos_viejos(compilacion);
+    } else if (!compilacion->cancelada) {
+        g_printerr("Advertencia: No se pudo precompilar el preámbulo; se compila sin formato\n");
+        g_atomic_int_set(&formato_no_disponible, 1);
+        g_clear_pointer(&compilacion->formato, g_free);
+    }
+    limpiar_construccion_formato(compilacion);
+    
+    g_free(nombre_temporal);
+    g_free(nombre_final);
+    g_free(ruta_temporal);
+    g_free(ruta_final);
+    
+    if (compilacion->cancelada) {
+        programar_fin(compilacion);
+    } else {
+        iniciar_pasada(compilacion);
+    }
+}
+
+// Construye el formato con pdftex -ini y mylatexformat a partir del preámbulo fijo
+static void construir_formato(CompilacionLatex *compilacion) {
+    compilacion->formato_temporal = g_strdup_printf("%s-%d-%d", compilacion->formato, (int)getpid(),
+                                                    g_atomic_int_add(&contador_formatos, 1));
+    
+    gchar *nombre_fuente = g_strdup_printf("%s.tex", compilacion->formato_temporal);
+    gchar *ruta_fuente = g_build_filename(compilacion->directorio, nombre_fuente, NULL);
+    gchar *fuente = g_strconcat(preambulo_latex(), MARCA_FIN_PREAMBULO "\n",
+                                "\\begin{document}\n\\end{document}\n", NULL);
+    g_file_set_contents(ruta_fuente, fuente, -1, NULL);
+    g_free(fuente);
+    g_free(ruta_fuente);
+    
+    gchar *opcion_nombre = g_strdup_printf("-jobname=%s", compilacion->formato_temporal);
+    gchar *argv[] = { "pdftex", "-ini", "-interaction=nonstopmode", opcion_nombre,
+                      "&pdflatex", "mylatexformat.ltx", nombre_fuente, NULL };
+    GError *error = NULL;
+    
+    gboolean lanzado = g_spawn_async(compilacion->directorio, argv, NULL,
+                                     G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD |
+                                     G_SPAWN_STDOUT_TO_DEV_NULL | G_SPAWN_STDERR_TO_DEV_NULL,
+                                     NULL, NULL, &compilacion->pid, &error);
+    g_free(opcion_nombre);
+    g_free(nombre_fuente);
+    
+    if (!lanzado) {
+        g_printerr("Advertencia: No se pudo ejecutar pdftex: %s\n", error->message);
+        g_error_free(error);
+        g_atomic_int_set(&formato_no_disponible, 1);
+        limpiar_construccion_formato(compilacion);
+        g_clear_pointer(&compilacion->formato, g_free);
+        iniciar_pasada(compilacion);
+        return;
+    }
+    
+    vigilar_proceso(compilacion, formato_construido);
+}
+
+// Usa el formato si ya existe; si no, lo construye antes de la primera pasada
+static void iniciar_compilacion(CompilacionLatex *compilacion) {
+    if (compilacion->formato) {
+        gchar *nombre = g_strdup_printf("%s.fmt", compilacion->formato);
+        gchar *ruta = g_build_filename(compilacion->directorio, nombre, NULL);
+        gboolean existe = g_file_test(ruta, G_FILE_TEST_EXISTS);
+        g_free(ruta);
+        g_free(nombre);
+        
+        if (!existe) {
+            construir_formato(compilacion);
+            return;
+        }
+    }
+    iniciar_pasada(compilacion);
+}
+
+// Compila el .tex en segundo plano. El aviso llega por el contexto principal del hilo
+// que llama (g_main_context_get_thread_default), así que varias compilaciones pueden
+// correr a la vez mientras ese contexto esté iterando.
+static CompilacionLatex* nueva_compilacion(const char *ruta_tex, CompilacionTerminadaFunc funcion, gpointer datos) {
+    CompilacionLatex *compilacion = g_new0(CompilacionLatex, 1);
+    gchar *nombre = g_path_get_basename(ruta_tex);
+    
+    compilacion->directorio = g_path_get_dirname(ruta_tex);
+    compilacion->nombre_tex = nombre;
+    compilacion->nombre_base = g_str_has_suffix(nombre, ".tex") ?
+                               g_strndup(nombre, strlen(nombre) - 4) : g_strdup(nombre);
+    gchar *nombre_pdf = g_strdup_printf("%s.pdf", compilacion->nombre_base);
+    compilacion->ruta_pdf = g_build_filename(compilacion->directorio, nombre_pdf, NULL);
+    g_free(nombre_pdf);
+    
+    // Un PDF de una compilación anterior no debe contar como resultado de esta
+    g_unlink(compilacion->ruta_pdf);
+    
+    compilacion->contexto = g_main_context_ref_thread_default();
+    compilacion->funcion = funcion;
+    compilacion->datos = datos;
+    return compilacion;
+}
+
+CompilacionLatex* compilar_latex_async(const char *ruta_tex, CompilacionTerminadaFunc funcion, gpointer datos) {
+    CompilacionLatex *compilacion = nueva_compilacion(ruta_tex, funcion, datos);
+    
+    analizar_documento(compilacion, ruta_tex);
+    if (compilacion->usa_referencias) {
+        compilacion->aux_previo = leer_auxiliar(compilacion, "aux");
+        compilacion->toc_previo = leer_auxiliar(compilacion, "toc");
+    }
+    
+    iniciar_compilacion(compilacion);
+    return compilacion;
+}
+
+// Detiene la pasada en curso; el aviso de fin llega igual, con COMPILACION_FALLIDA
+void compilacion_latex_cancelar(CompilacionLatex *compilacion) {
+    if (!compilacion || compilacion->cancelada) return;
+    
+    compilacion->cancelada = TRUE;
+    if (compilacion->pid > 0) {
+        kill(compilacion->pid, SIGTERM);
+    }
+}
+
+typedef struct {
+    gboolean terminada;
+    EstadoCompilacion estado;
+} EsperaCompilacion;
+
+static void compilacion_esperada(const char *ruta_pdf, EstadoCompilacion estado, gpointer datos) {
+    EsperaCompilacion *espera = datos;
+    espera->terminada = TRUE;
+    espera->estado = estado;
+}
+
+// Versión bloqueante: itera un contexto propio hasta que termina la compilación
+EstadoCompilacion compilar_latex(const char *ruta_tex) {
+    GMainContext *contexto = g_main_context_new();
+    EsperaCompilacion espera = { FALSE, COMPILACION_FALLIDA };
+    
+    g_main_context_push_thread_default(contexto);
+    compilar_latex_async(ruta_tex, compilacion_esperada, &espera);
+    while (!espera.terminada) {
+        g_main_context_iteration(contexto, TRUE);
+    }
+    g_main_context_pop_thread_default(contexto);
+    g_main_context_unref(contexto);
+    
+    return espera.estado;
+}
+
+// Abre el PDF con evince sin esperar a que se cierre
+void abrir_pdf(const char *ruta_pdf) {
+    gchar *argv[] = { "evince", "--presentation", (gchar*)ruta_pdf, NULL };
+    GError *error = NULL;
+    
+    if (!g_spawn_async(NULL, argv, NULL,
+                       G_SPAWN_SEARCH_PATH | G_SPAWN_STDOUT_TO_DEV_NULL | G_SPAWN_STDERR_TO_DEV_NULL,
+                       NULL, NULL, NULL, &error)) {
+        g_printerr("Error: No se pudo abrir el PDF: %s\n", error->message);
+        g_error_free(error);
+        return;
+    }
+    
+    g_print("PDF generado y abierto: %s\n", ruta_pdf);
+}
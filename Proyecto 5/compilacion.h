@@ -0,0 +1,34 @@
+#ifndef COMPILACION_H
+#define COMPILACION_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+// Carpeta donde se escriben los .tex y se generan los PDF
+#define DIRECTORIO_REPORTES "ProblemasSimplex"
+
+// Compilación de un reporte en curso (opaca)
+typedef struct CompilacionLatex CompilacionLatex;
+
+// Cómo terminó una compilación. El PDF anterior se borra antes de empezar, así que
+// en los dos últimos casos el PDF es siempre de esta compilación.
+typedef enum {
+    COMPILACION_FALLIDA,        // Cancelada o sin PDF
+    COMPILACION_CON_ERRORES,    // Hay PDF, pero pdflatex informó errores (se conserva el .log)
+    COMPILACION_CORRECTA
+} EstadoCompilacion;
+
+// Se llama en el contexto principal del hilo que inició la compilación
+typedef void (*CompilacionTerminadaFunc)(const char *ruta_pdf, EstadoCompilacion estado, gpointer datos);
+
+// Prototipos de funciones
+gchar* ruta_reporte(const char *nombre_archivo);
+CompilacionLatex* compilar_latex_async(const char *ruta_tex, CompilacionTerminadaFunc funcion, gpointer datos);
+void compilacion_latex_cancelar(CompilacionLatex *compilacion);
+EstadoCompilacion compilar_latex(const char *ruta_tex);
+void abrir_pdf(const char *ruta_pdf);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,351 @@
+#include "csv.h"
+#include "formato.h"
+#include "salida.h"
+#include <string.h>
+#include <stdlib.h>
+
+// Texto dentro del archivo mapeado; nunca se copia ni se termina en '\0'
+typedef struct {
+    const char *inicio;
+    gsize largo;
+} CampoCsv;
+
+// Fila R o RS pendiente de leer, con su número de línea para los mensajes de error
+typedef struct {
+    CampoCsv linea;
+    int num_linea;
+} FilaCsv;
+
+// Recorre los campos de una línea separados por comas
+typedef struct {
+    const char *pos;
+    const char *fin;
+    gboolean terminado;
+} CursorCsv;
+
+static CampoCsv recortar(const char *inicio, const char *fin) {
+    while (inicio < fin && g_ascii_isspace(*inicio)) inicio++;
+    while (fin > inicio && g_ascii_isspace(fin[-1])) fin--;
+    CampoCsv campo = { inicio, (gsize)(fin - inicio) };
+    return campo;
+}
+
+static CursorCsv cursor_linea(CampoCsv linea) {
+    CursorCsv cursor = { linea.inicio, linea.inicio + linea.largo, FALSE };
+    return cursor;
+}
+
+// Igual que g_strsplit: "a,,b," da cuatro campos, el último vacío
+static gboolean siguiente_campo(CursorCsv *cursor, CampoCsv *campo) {
+    if (cursor->terminado) return FALSE;
+    const char *coma = memchr(cursor->pos, ',', (gsize)(cursor->fin - cursor->pos));
+    const char *fin = coma ? coma : cursor->fin;
+    *campo = recortar(cursor->pos, fin);
+    cursor->pos = coma ? coma + 1 : cursor->fin;
+    cursor->terminado = (coma == NULL);
+    return TRUE;
+}
+
+static int contar_campos(CampoCsv linea) {
+    CursorCsv cursor = cursor_linea(linea);
+    CampoCsv campo;
+    int n = 0;
+    while (siguiente_campo(&cursor, &campo)) n++;
+    return n;
+}
+
+static gboolean campo_es(CampoCsv campo, const char *texto) {
+    return campo.largo == strlen(texto) && memcmp(campo.inicio, texto, campo.largo) == 0;
+}
+
+// Potencias de 10 exactas en double (hasta 10^22)
+static const double POTENCIAS_10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Convierte un campo a double. Los números cortos sin exponente (lo habitual en estos
+// archivos) se arman con enteros: una mantisa de hasta 15 dígitos y una sola división
+// por una potencia de 10 exacta dan el mismo double que strtod. El resto, y cualquier
+// cosa rara, pasa por g_ascii_strtod. Devuelve FALSE si el campo no es un número completo.
+static gboolean campo_a_double_valido(CampoCsv campo, double *valor) {
+    const char *p = campo.inicio;
+    const char *fin = campo.inicio + campo.largo;
+    double signo = 1.0;
+    if (p < fin && (*p == '-' || *p == '+')) {
+        if (*p == '-') signo = -1.0;
+        p++;
+    }
+
+    guint64 mantisa = 0;
+    int digitos = 0, decimales = 0;
+    gboolean punto = FALSE;
+    for (; p < fin; p++) {
+        if (*p >= '0' && *p <= '9') {
+            mantisa = mantisa * 10 + (guint64)(*p - '0');
+            digitos++;
+            if (punto) decimales++;
+        } else if (*p == '.' && !punto) {
+            punto = TRUE;
+        } else {
+            break;
+        }
+    }
+    if (p == fin && digitos > 0 && digitos <= 15) {
+        *valor = signo * ((double)mantisa / POTENCIAS_10[decimales]);
+        return TRUE;
+    }
+
+    char numero[64];
+    gsize largo = MIN(campo.largo, sizeof(numero) - 1);
+    memcpy(numero, campo.inicio, largo);
+    numero[largo] = '\0';
+    char *resto;
+    *valor = g_ascii_strtod(numero, &resto);
+    return largo > 0 && largo == campo.largo && resto == numero + largo;
+}
+
+// Para los campos que se toleran mal formados: cualquier cosa rara da lo que lea strtod
+static double campo_a_double(CampoCsv campo) {
+    double valor;
+    campo_a_double_valido(campo, &valor);
+    return valor;
+}
+
+static int campo_a_int(CampoCsv campo) {
+    char numero[32];
+    gsize largo = MIN(campo.largo, sizeof(numero) - 1);
+    memcpy(numero, campo.inicio, largo);
+    numero[largo] = '\0';
+    return atoi(numero);
+}
+
+// Índice de una entrada RS: solo dígitos, sin signo ni espacios de más
+static gboolean campo_a_indice(CampoCsv campo, int *indice) {
+    if (campo.largo == 0 || campo.largo > 9) return FALSE;
+    int n = 0;
+    for (gsize i = 0; i < campo.largo; i++) {
+        if (!g_ascii_isdigit(campo.inicio[i])) return FALSE;
+        n = n * 10 + (campo.inicio[i] - '0');
+    }
+    *indice = n;
+    return TRUE;
+}
+
+// Operador de una fila R; cualquier otro texto cuenta como "<="
+static TipoRestriccion restriccion_desde_campo(CampoCsv campo) {
+    if (campo_es(campo, ">=")) return RESTRICCION_GE;
+    if (campo_es(campo, "=")) return RESTRICCION_EQ;
+    return RESTRICCION_LE;
+}
+
+// Segundo campo de una línea (el valor de NAME, TYPE, N y M)
+static gboolean valor_registro(CampoCsv linea, CampoCsv *valor) {
+    CursorCsv cursor = cursor_linea(linea);
+    CampoCsv clave;
+    return siguiente_campo(&cursor, &clave) && siguiente_campo(&cursor, valor);
+}
+
+static void leer_fila(Modelo *modelo, int r, CampoCsv linea) {
+    CursorCsv cursor = cursor_linea(linea);
+    CampoCsv campo;
+    int n = modelo->num_vars;
+
+    siguiente_campo(&cursor, &campo);   // "R"
+    for (int i = 0; i < n && siguiente_campo(&cursor, &campo); i++) {
+        modelo->A[r][i] = campo_a_double(campo);
+    }
+    if (siguiente_campo(&cursor, &campo)) {
+        modelo->tipos_restricciones[r] = restriccion_desde_campo(campo);
+        if (siguiente_campo(&cursor, &campo)) {
+            modelo->lados_derechos[r] = campo_a_double(campo);
+        }
+    }
+}
+
+// Fila dispersa: "RS,j:a,...,op,b" con j de 1 a N. Un índice repetido se suma, así que
+// el costo depende solo de los no ceros. Devuelve FALSE (y lo informa con g_printerr)
+// si un índice está fuera de rango o una entrada no es un número.
+static gboolean leer_fila_dispersa(Modelo *modelo, int r, FilaCsv fila, const char *ruta) {
+    CursorCsv cursor = cursor_linea(fila.linea);
+    CampoCsv campo;
+
+    siguiente_campo(&cursor, &campo);   // "RS"
+    while (siguiente_campo(&cursor, &campo)) {
+        const char *dos_puntos = memchr(campo.inicio, ':', campo.largo);
+        if (!dos_puntos) {
+            modelo->tipos_restricciones[r] = restriccion_desde_campo(campo);
+            if (siguiente_campo(&cursor, &campo)) {
+                modelo->lados_derechos[r] = campo_a_double(campo);
+            }
+            return TRUE;
+        }
+
+        CampoCsv indice = recortar(campo.inicio, dos_puntos);
+        CampoCsv valor = recortar(dos_puntos + 1, campo.inicio + campo.largo);
+        int j;
+        if (!campo_a_indice(indice, &j) || j < 1 || j > modelo->num_vars) {
+            g_printerr("%s:%d: índice de variable inválido '%.*s' (debe ir de 1 a %d)\n",
+                       ruta, fila.num_linea, (int)indice.largo, indice.inicio, modelo->num_vars);
+            return FALSE;
+        }
+        double coeficiente;
+        if (!campo_a_double_valido(valor, &coeficiente)) {
+            g_printerr("%s:%d: coeficiente inválido '%.*s'\n",
+                       ruta, fila.num_linea, (int)valor.largo, valor.inicio);
+            return FALSE;
+        }
+        modelo->A[r][j - 1] += coeficiente;
+    }
+    return TRUE;
+}
+
+// Lee un problema guardado por la interfaz (registros NAME, TYPE, N, VARS, M, Z y R)
+// sin depender de GTK. El archivo se mapea en memoria y los campos se leen en su
+// lugar, sin partirlo en cadenas. Devuelve NULL si el archivo no existe, le faltan datos
+// o una fila RS tiene una entrada inválida.
+Modelo* modelo_cargar_csv(const char *ruta) {
+    GMappedFile *archivo = ruta ? g_mapped_file_new(ruta, FALSE, NULL) : NULL;
+    if (!archivo) return NULL;
+
+    // Un archivo vacío se mapea sin contenido
+    gsize largo = g_mapped_file_get_length(archivo);
+    const char *datos = largo > 0 ? g_mapped_file_get_contents(archivo) : "";
+    const char *fin = datos + largo;
+    CampoCsv nombre = { NULL, 0 }, tipo = { NULL, 0 }, vars = { NULL, 0 }, z = { NULL, 0 };
+    gboolean con_vars = FALSE, con_z = FALSE;
+    GArray *filas = g_array_new(FALSE, FALSE, sizeof(FilaCsv));
+    int n = -1, m = -1, num_linea = 0;
+
+    // Primero se ubican los registros; las filas se leen cuando se conozca N
+    for (const char *p = datos; p < fin; ) {
+        const char *salto = memchr(p, '\n', (gsize)(fin - p));
+        CampoCsv linea = recortar(p, salto ? salto : fin);
+        p = salto ? salto + 1 : fin;
+        num_linea++;
+        if (linea.largo == 0) continue;
+
+        CursorCsv cursor = cursor_linea(linea);
+        CampoCsv clave, valor;
+        siguiente_campo(&cursor, &clave);
+        gboolean con_valor = valor_registro(linea, &valor);
+
+        if (campo_es(clave, "NAME") && con_valor) {
+            nombre = valor;
+        } else if (campo_es(clave, "TYPE") && con_valor) {
+            tipo = valor;
+        } else if (campo_es(clave, "VARS") && con_valor) {
+            vars = linea;
+            con_vars = TRUE;
+        } else if (campo_es(clave, "Z")) {
+            z = linea;
+            con_z = TRUE;
+        } else if (campo_es(clave, "N") && con_valor) {
+            n = campo_a_int(valor);
+        } else if (campo_es(clave, "M") && con_valor) {
+            m = campo_a_int(valor);
+        } else if (campo_es(clave, "R") || campo_es(clave, "RS")) {
+            FilaCsv fila = { linea, num_linea };
+            g_array_append_val(filas, fila);
+        }
+    }
+
+    Modelo *modelo = NULL;
+    if (n > 0 && m >= 0 && con_vars && contar_campos(vars) - 1 == n && con_z) {
+        gboolean minimizar = tipo.largo == 3 && g_ascii_strncasecmp(tipo.inicio, "MIN", 3) == 0;
+        gchar *texto_nombre = nombre.inicio ? g_strndup(nombre.inicio, nombre.largo) : NULL;
+        modelo = modelo_nuevo(texto_nombre, minimizar ? MINIMIZACION : MAXIMIZACION, n, m);
+        g_free(texto_nombre);
+
+        CursorCsv cursor = cursor_linea(vars);
+        CampoCsv campo;
+        siguiente_campo(&cursor, &campo);
+        for (int i = 0; i < n && siguiente_campo(&cursor, &campo); i++) {
+            modelo->nombres_vars[i] = arena_strdup_printf(modelo->arena, "%.*s", (int)campo.largo, campo.inicio);
+        }
+
+        cursor = cursor_linea(z);
+        siguiente_campo(&cursor, &campo);
+        for (int i = 0; i < n && siguiente_campo(&cursor, &campo); i++) {
+            modelo->c[i] = campo_a_double(campo);
+        }
+
+        // Las restricciones que falten en el archivo quedan en cero
+        for (int r = 0; r < m && r < (int)filas->len; r++) {
+            FilaCsv fila = g_array_index(filas, FilaCsv, r);
+            if (fila.linea.largo >= 2 && fila.linea.inicio[1] == 'S') {
+                if (!leer_fila_dispersa(modelo, r, fila, ruta)) {
+                    modelo_liberar(modelo);
+                    modelo = NULL;
+                    break;
+                }
+            } else {
+                leer_fila(modelo, r, fila.linea);
+            }
+        }
+    }
+
+    g_array_free(filas, TRUE);
+    g_mapped_file_unref(archivo);
+    return modelo;
+}
+
+static void escribir_numero(Salida *salida, double valor) {
+    char buf[FORMATO_TAM_BUFER];
+    gsize largo = formato_double_exacto(valor, buf, sizeof(buf));
+    salida_append_len(salida, buf, largo);
+}
+
+// Escribe el modelo en el formato que lee modelo_cargar_csv. Cada restricción va en la
+// forma que ocupe menos: R con los N coeficientes, o RS con solo los no ceros. Así los
+// problemas pequeños y densos siguen siendo legibles por versiones anteriores.
+gboolean modelo_guardar_csv(const Modelo *modelo, const char *ruta) {
+    static const char *operadores[] = { "<=", ">=", "=" };
+    int n = modelo->num_vars;
+
+    Salida *salida = salida_archivo(ruta);
+    if (!salida) return FALSE;
+
+    salida_printf(salida, "NAME,%s\nTYPE,%s\nN,%d\nVARS",
+                  modelo->nombre, modelo->tipo == MINIMIZACION ? "MIN" : "MAX", n);
+    for (int i = 0; i < n; i++) {
+        salida_append_c(salida, ',');
+        salida_append(salida, modelo->nombres_vars[i]);
+    }
+    salida_printf(salida, "\nM,%d\nZ", modelo->num_rest);
+    for (int i = 0; i < n; i++) {
+        salida_append_c(salida, ',');
+        escribir_numero(salida, modelo->c[i]);
+    }
+    salida_append_c(salida, '\n');
+
+    for (int r = 0; r < modelo->num_rest; r++) {
+        const double *fila = modelo->A[r];
+        int no_ceros = 0;
+        for (int i = 0; i < n; i++) {
+            if (fila[i] != 0.0) no_ceros++;
+        }
+
+        // Cada no cero cuesta su índice de más en RS y cada cero ahorra "0,": con menos
+        // de una cuarta parte de no ceros, RS siempre queda más corta
+        if (no_ceros * 4 < n) {
+            salida_append(salida, "RS");
+            for (int i = 0; i < n; i++) {
+                if (fila[i] == 0.0) continue;
+                salida_printf(salida, ",%d:", i + 1);
+                escribir_numero(salida, fila[i]);
+            }
+        } else {
+            salida_append_c(salida, 'R');
+            for (int i = 0; i < n; i++) {
+                salida_append_c(salida, ',');
+                escribir_numero(salida, fila[i]);
+            }
+        }
+        salida_printf(salida, ",%s,", operadores[modelo->tipos_restricciones[r]]);
+        escribir_numero(salida, modelo->lados_derechos[r]);
+        salida_append_c(salida, '\n');
+    }
+
+    return salida_cerrar(salida);
+}
@@ -0,0 +1,34 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <glib.h>
+#include "modelo.h"
+
+G_BEGIN_DECLS
+
+// Formato CSV con que la interfaz guarda los problemas, un registro por línea:
+//
+//     NAME,Ejemplo
+//     TYPE,MAX
+//     N,2
+//     VARS,X1,X2
+//     M,1
+//     Z,3,5
+//     R,1,2,<=,4
+//
+// Cada R lleva los n coeficientes, el operador (<=, >= o =) y el lado derecho.
+// Una restricción también puede ir en forma dispersa, con solo los coeficientes
+// distintos de cero y su índice de 1 a N:
+//
+//     RS,2:5,7:-1.5,>=,3
+//
+// Las R y RS se cuentan juntas, en orden. Las restricciones que falten quedan en cero.
+// Un índice fuera de 1..N o una entrada RS que no sea un número hace fallar la carga.
+
+// Prototipos de funciones
+Modelo* modelo_cargar_csv(const char *ruta);
+gboolean modelo_guardar_csv(const Modelo *modelo, const char *ruta);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,235 @@
+#include "formato.h"
+#include <math.h>
+#include <string.h>
+
+// Denominador máximo de las fracciones que se reconocen en los reportes
+#define MAX_DENOMINADOR 12
+
+// Mayor magnitud con la que todos los enteros son exactos en un double (2^53)
+#define MAX_ENTERO_EXACTO 9007199254740992.0
+
+static const char DIGITOS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Entero más cercano a un valor no negativo menor que 2^53 (desde 2^52 todos son enteros)
+static double entero_cercano(double magnitud) {
+    return magnitud >= 0x1p52 ? magnitud : (double)(gint64)(magnitud + 0.5);
+}
+
+// Escribe 'n' en decimal al final de 'fin' (hacia atrás) y devuelve el inicio
+static char* escribir_entero_atras(guint64 n, char *fin) {
+    char *p = fin;
+    while (n >= 100) {
+        guint d = (guint)(n % 100) * 2;
+        n /= 100;
+        *--p = DIGITOS[d + 1];
+        *--p = DIGITOS[d];
+    }
+    if (n >= 10) {
+        guint d = (guint)n * 2;
+        *--p = DIGITOS[d + 1];
+        *--p = DIGITOS[d];
+    } else {
+        *--p = (char)('0' + n);
+    }
+    return p;
+}
+
+// Copia el resultado al búfer del llamador, truncando como snprintf
+static gsize copiar(const char *texto, gsize largo, char *buffer, gsize tam) {
+    if (tam == 0) return largo;
+    gsize n = MIN(largo, tam - 1);
+    memcpy(buffer, texto, n);
+    buffer[n] = '\0';
+    return largo;
+}
+
+// Entero con signo; 'negativo' permite escribir "-0" como lo hace printf
+static gsize escribir_entero(guint64 magnitud, gboolean negativo, char *buffer, gsize tam) {
+    char temp[24];
+    char *fin = temp + sizeof(temp);
+    char *p = escribir_entero_atras(magnitud, fin);
+    if (negativo) *--p = '-';
+    return copiar(p, (gsize)(fin - p), buffer, tam);
+}
+
+static gsize formato_printf(const char *formato, double valor, char *buffer, gsize tam) {
+    char temp[G_ASCII_DTOSTR_BUF_SIZE + 320];
+    g_ascii_formatd(temp, sizeof(temp), formato, valor);
+    return copiar(temp, strlen(temp), buffer, tam);
+}
+
+// Número para las tablas: entero si está a menos de 1e-4 de uno, si no con 4 decimales.
+// Produce el mismo texto que "%.0f" / "%.4f".
+gsize formato_numero(double valor, char *buffer, gsize tam) {
+    double magnitud = fabs(valor);
+
+    if (magnitud < MAX_ENTERO_EXACTO) {
+        double entero = entero_cercano(magnitud);
+        if (fabs(magnitud - entero) < 0.0001) {
+            return escribir_entero((guint64)entero, signbit(valor), buffer, tam);
+        }
+    }
+
+    // Con cuatro decimales el valor escalado debe seguir siendo un entero exacto
+    if (magnitud < MAX_ENTERO_EXACTO / 10000.0) {
+        double escalado = magnitud * 10000.0;
+        guint64 n = (guint64)escalado;
+        double resto = escalado - (double)n;
+
+        // Cerca de la mitad el redondeo de la multiplicación podría cambiar el
+        // resultado; ese caso raro lo decide printf sobre el valor exacto
+        if (fabs(resto - 0.5) > escalado * 0x1p-50) {
+            if (resto > 0.5) n++;
+
+            char temp[32];
+            char *fin = temp + sizeof(temp);
+            char *p = fin;
+            guint decimales = (guint)(n % 10000);
+            *--p = DIGITOS[(decimales % 100) * 2 + 1];
+            *--p = DIGITOS[(decimales % 100) * 2];
+            *--p = DIGITOS[(decimales / 100) * 2 + 1];
+            *--p = DIGITOS[(decimales / 100) * 2];
+            *--p = '.';
+            p = escribir_entero_atras(n / 10000, p);
+            if (valor < 0) *--p = '-';
+            return copiar(p, (gsize)(fin - p), buffer, tam);
+        }
+    }
+
+    if (magnitud >= MAX_ENTERO_EXACTO) {
+        return formato_printf("%.0f", valor, buffer, tam);
+    }
+    return formato_printf("%.4f", valor, buffer, tam);
+}
+
+// Fracción en LaTeX (\frac{p}{q}, q <= 12) si el valor está a menos de 'tolerancia'
+// de una; entero si está cerca de uno, y si no, como formato_numero. La fracción se
+// busca con las convergentes de la fracción continua: cualquier p/q tan cercana
+// (|v - p/q| < 1/2q^2) es una de ellas, y no hacen falta más de cinco o seis.
+gsize formato_fraccion_latex(double valor, double tolerancia, char *buffer, gsize tam) {
+    double magnitud = fabs(valor);
+
+    if (magnitud < MAX_ENTERO_EXACTO) {
+        double entero = entero_cercano(magnitud);
+        if (fabs(magnitud - entero) < tolerancia) {
+            return escribir_entero((guint64)entero, signbit(valor), buffer, tam);
+        }
+    } else if (!isnan(magnitud)) {
+        return formato_printf("%.0f", valor, buffer, tam);
+    }
+
+    if (magnitud < (double)G_MAXINT / MAX_DENOMINADOR) {
+        gint64 h_anterior = 0, h = 1;   // Numeradores de las dos últimas convergentes
+        gint64 k_anterior = 1, k = 0;   // y sus denominadores
+        double x = magnitud;
+
+        for (;;) {
+            double a = floor(x);
+            if (k > 0 && a > MAX_DENOMINADOR) break;
+
+            gint64 h_nuevo = (gint64)a * h + h_anterior;
+            gint64 k_nuevo = (gint64)a * k + k_anterior;
+            if (k_nuevo > MAX_DENOMINADOR) break;
+            h_anterior = h; h = h_nuevo;
+            k_anterior = k; k = k_nuevo;
+
+            if (k >= 2 && fabs(magnitud - (double)h / k) < tolerancia) {
+                char temp[48];
+                char *fin = temp + sizeof(temp);
+                char *p = fin;
+                *--p = '}';
+                p = escribir_entero_atras((guint64)k, p);
+                *--p = '{';
+                *--p = '}';
+                p = escribir_entero_atras((guint64)h, p);
+                p -= 6;
+                memcpy(p, "\\frac{", 6);
+                if (valor < 0) *--p = '-';
+                return copiar(p, (gsize)(fin - p), buffer, tam);
+            }
+
+            double resto = x - a;
+            if (resto <= 0) break;
+            x = 1.0 / resto;
+        }
+    }
+
+    return formato_numero(valor, buffer, tam);
+}
+
+// Valor de la fila Z del método de la Gran M: los múltiplos de M se escriben en forma
+// simbólica ("M", "-3M", "2.5M"); el resto como formato_numero, con 0 bajo 'epsilon'
+gsize formato_valor_gran_m(double valor, double m_grande, double epsilon, char *buffer, gsize tam) {
+    if (fabs(valor) > m_grande / 10) {
+        double coef_m = valor / m_grande;
+        char temp[FORMATO_TAM_BUFER];
+        gsize largo;
+        if (fabs(coef_m - round(coef_m)) < epsilon) {
+            if (fabs(coef_m - 1.0) < epsilon) {
+                return copiar("M", 1, buffer, tam);
+            } else if (fabs(coef_m + 1.0) < epsilon) {
+                return copiar("-M", 2, buffer, tam);
+            }
+            largo = formato_printf("%.0f", coef_m, temp, sizeof(temp) - 1);
+        } else {
+            largo = formato_printf("%.1f", coef_m, temp, sizeof(temp) - 1);
+        }
+        largo = MIN(largo, sizeof(temp) - 2);
+        temp[largo++] = 'M';
+        return copiar(temp, largo, buffer, tam);
+    }
+    if (fabs(valor) < epsilon) {
+        return copiar("0", 1, buffer, tam);
+    }
+    return formato_numero(valor, buffer, tam);
+}
+
+// Decimal más corto que al leerse con g_ascii_strtod devuelve exactamente el mismo
+// double. Es lo que se escribe en CSV y JSON para no perder ni inventar dígitos.
+gsize formato_double_exacto(double valor, char *buffer, gsize tam) {
+    double magnitud = fabs(valor);
+
+    if (magnitud < MAX_ENTERO_EXACTO && magnitud == (double)(gint64)magnitud) {
+        return escribir_entero((guint64)magnitud, signbit(valor), buffer, tam);
+    }
+
+    // Hasta cuatro decimales: bajo 1e9 dos valores distintos con cuatro decimales
+    // nunca dan el mismo double, así que este texto es además el más corto
+    if (magnitud < 1e9) {
+        double escalado = magnitud * 10000.0;
+        guint64 n = (guint64)escalado;
+        if ((double)n == escalado && (double)n / 10000.0 == magnitud) {
+            char temp[32];
+            char *fin = temp + sizeof(temp);
+            char *p = fin;
+            guint decimales = (guint)(n % 10000);
+            int cifras = 4;
+            while (decimales % 10 == 0) {
+                decimales /= 10;
+                cifras--;
+            }
+            for (int i = 0; i < cifras; i++) {
+                *--p = (char)('0' + decimales % 10);
+                decimales /= 10;
+            }
+            *--p = '.';
+            p = escribir_entero_atras(n / 10000, p);
+            if (valor < 0) *--p = '-';
+            return copiar(p, (gsize)(fin - p), buffer, tam);
+        }
+    }
+
+    // Caso general: la menor precisión que sobrevive a la ida y vuelta
+    char temp[G_ASCII_DTOSTR_BUF_SIZE];
+    static const char *formatos[] = { "%.15g", "%.16g" };
+    for (gsize i = 0; i < G_N_ELEMENTS(formatos); i++) {
+        g_ascii_formatd(temp, sizeof(temp), formatos[i], valor);
+        if (g_ascii_strtod(temp, NULL) == valor) {
+            return copiar(temp, strlen(temp), buffer, tam);
+        }
+    }
+    return formato_printf("%.17g", valor, buffer, tam);
+}
@@ -0,0 +1,23 @@
+#ifndef FORMATO_H
+#define FORMATO_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+// Formateo de números para reportes y archivos. Los casos comunes se escriben
+// directamente, sin pasar por printf; los raros caen a g_ascii_formatd. La salida
+// no depende del locale (siempre con punto decimal).
+
+// Tamaño suficiente para cualquier resultado de estas funciones
+#define FORMATO_TAM_BUFER 64
+
+// Prototipos de funciones
+gsize formato_numero(double valor, char *buffer, gsize tam);
+gsize formato_fraccion_latex(double valor, double tolerancia, char *buffer, gsize tam);
+gsize formato_valor_gran_m(double valor, double m_grande, double epsilon, char *buffer, gsize tam);
+gsize formato_double_exacto(double valor, char *buffer, gsize tam);
+
+G_END_DECLS
+
+#endif
@@ -1,5 +1,7 @@
 #include "latex.h"
+#include "formato.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <glib.h>
@@ -45,46 +47,11 @@ static char* escape_latex(const char *texto) {
 
 // Funciones auxiliares para formateo de números y variables
 static void formatear_numero(double valor, char *buffer, size_t buffer_size) {
-    if (fabs(valor - round(valor)) < 0.0001) {
-        snprintf(buffer, buffer_size, "%.0f", valor);
-    } else {
-        snprintf(buffer, buffer_size, "%.4f", valor);
-        for (char *p = buffer; *p; p++) {
-            if (*p == ',') *p = '.';
-        }
-    }
+    formato_numero(valor, buffer, buffer_size);
 }
 
 static void formatear_fraccion(double valor, char *buffer, size_t buffer_size) {
-    double valor_abs = fabs(valor);
-    
-    if (fabs(valor_abs - round(valor_abs)) < EPSILON) {
-        snprintf(buffer, buffer_size, "%.0f", valor);
-    } else {
-        int numerador, denominador;
-        int encontrado = 0;
-        
-        for (denominador = 2; denominador <= 12; denominador++) {
-            numerador = round(valor_abs * denominador);
-            if (fabs(valor_abs - (double)numerador/denominador) < EPSILON) {
-                if (denominador == 1) {
-                    snprintf(buffer, buffer_size, "%s%d", (valor < 0) ? "-" : "", numerador);
-                } else {
-                    if (valor < 0) {
-                        snprintf(buffer, buffer_size, "-\\frac{%d}{%d}", numerador, denominador);
-                    } else {
-                        snprintf(buffer, buffer_size, "\\frac{%d}{%d}", numerador, denominador);
-                    }
-                }
-                encontrado = 1;
-                break;
-            }
-        }
-        
-        if (!encontrado) {
-            formatear_numero(valor, buffer, buffer_size);
-        }
-    }
+    formato_fraccion_latex(valor, EPSILON, buffer, buffer_size);
 }
 
 static void formatear_nombre_variable_latex(const char *nombre_original, char *buffer, size_t buffer_size) {
@@ -138,11 +105,11 @@ static void formatear_nombre_variable_tabla(const char *nombre_original, char *b
 }
 
 // Función para mostrar cálculos de razones con fracciones
-static void mostrar_calculos_pivote(GString *latex, TablaSimplex *tabla, int columna_entra) {
+static void mostrar_calculos_pivote(Salida *latex, TablaSimplex *tabla, int columna_entra) {
     if (!tabla || columna_entra < 0) return;
     
-    g_string_append(latex, "\\textbf{Cálculo de razones para seleccionar pivote:}\n");
-    g_string_append(latex, "\\begin{itemize}\n");
+    salida_append(latex, "\\textbf{Cálculo de razones para seleccionar pivote:}\n");
+    salida_append(latex, "\\begin{itemize}\n");
     
     double menor_razon = 1e9;
     int fila_pivote = -1;
@@ -159,7 +126,7 @@ static void mostrar_calculos_pivote(GString *latex, TablaSimplex *tabla, int col
             formatear_numero(elemento_columna, elemento_buffer, sizeof(elemento_buffer));
             formatear_fraccion(razon, razon_buffer, sizeof(razon_buffer));
             
-            g_string_append_printf(latex, "\\item Fila %d: $\\frac{%s}{%s} = %s$\n", 
+            salida_printf(latex, "\\item Fila %d: $\\frac{%s}{%s} = %s$\n", 
                                   i, termino_buffer, elemento_buffer, razon_buffer);
             
             if (razon < menor_razon) {
@@ -172,48 +139,58 @@ static void mostrar_calculos_pivote(GString *latex, TablaSimplex *tabla, int col
     if (fila_pivote > 0) {
         char menor_razon_buffer[32];
         formatear_fraccion(menor_razon, menor_razon_buffer, sizeof(menor_razon_buffer));
-        g_string_append_printf(latex, "\\item \\textbf{Razón mínima:} %s (Fila %d)\n", 
+        salida_printf(latex, "\\item \\textbf{Razón mínima:} %s (Fila %d)\n", 
                               menor_razon_buffer, fila_pivote);
     }
     
-    g_string_append(latex, "\\end{itemize}\n\n");
+    salida_append(latex, "\\end{itemize}\n\n");
+}
+
+// Preámbulo fijo de todos los reportes. Se precompila en un formato de pdflatex,
+// así que cualquier cambio aquí genera un formato nuevo automáticamente.
+static const char PREAMBULO_LATEX[] =
+    "\\documentclass[12pt]{article}\n"
+    "\\usepackage[utf8]{inputenc}\n"
+    "\\usepackage[spanish]{babel}\n"
+    "\\usepackage{amsmath,amssymb}\n"
+    "\\usepackage{booktabs}\n"
+    "\\usepackage{xcolor}\n"
+    "\\usepackage[table]{xcolor}\n"
+    "\\usepackage{graphicx}\n"
+    "\\usepackage{geometry}\n"
+    "\\usepackage{colortbl}\n"
+    "\\usepackage{array}\n"  
+    "\\usepackage{tikz}\n"
+    "\\usetikzlibrary{shapes,arrows,positioning,calc}\n"
+    "\\geometry{margin=2.5cm}\n"
+    "\\usepackage{fancyhdr}\n"
+    "\\usepackage{multirow}\n"
+    "\\usepackage{float}\n"
+    "\\setlength{\\headheight}{14.5pt}\n"
+    "\\pagestyle{fancy}\n"
+    "\\fancyhf{}\n"
+    "\\rhead{Investigación de Operaciones}\n"
+    "\\lhead{Método Simplex}\n"
+    "\n"
+    "\\definecolor{basecolor}{RGB}{200,255,200}\n"
+    "\\definecolor{entracolor}{RGB}{255,150,150}\n"    
+    "\\definecolor{salecolor}{RGB}{255,200,100}\n"     
+    "\\definecolor{pivotecolor}{RGB}{200,100,255}\n"   
+    "\\definecolor{empatecolor}{RGB}{255,255,100}\n"
+    "\\definecolor{calculocolor}{RGB}{100,255,255}\n"
+    "\n";
+
+const char* preambulo_latex(void) {
+    return PREAMBULO_LATEX;
 }
 
 // Función para generar la portada y encabezado del documento
-static void generar_portada_latex(GString *latex, const char *nombre_problema) {
+static void generar_portada_latex(Salida *latex, const char *nombre_problema) {
     char *nombre_escape = escape_latex(nombre_problema);
     
-    g_string_append_printf(latex,
-        "\\documentclass[12pt]{article}\n"
-        "\\usepackage[utf8]{inputenc}\n"
-        "\\usepackage[spanish]{babel}\n"
-        "\\usepackage{amsmath,amssymb}\n"
-        "\\usepackage{booktabs}\n"
-        "\\usepackage{xcolor}\n"
-        "\\usepackage[table]{xcolor}\n"
-        "\\usepackage{graphicx}\n"
-        "\\usepackage{geometry}\n"
-        "\\usepackage{colortbl}\n"
-        "\\usepackage{array}\n"  
-        "\\usepackage{tikz}\n"
-        "\\usetikzlibrary{shapes,arrows,positioning,calc}\n"
-        "\\geometry{margin=2.5cm}\n"
-        "\\usepackage{fancyhdr}\n"
-        "\\usepackage{multirow}\n"
-        "\\usepackage{float}\n"
-        "\\setlength{\\headheight}{14.5pt}\n"
-        "\\pagestyle{fancy}\n"
-        "\\fancyhf{}\n"
-        "\\rhead{Investigación de Operaciones}\n"
-        "\\lhead{Método Simplex}\n"
-        "\n"
-        "\\definecolor{basecolor}{RGB}{200,255,200}\n"
-        "\\definecolor{entracolor}{RGB}{255,150,150}\n"    
-        "\\definecolor{salecolor}{RGB}{255,200,100}\n"     
-        "\\definecolor{pivotecolor}{RGB}{200,100,255}\n"   
-        "\\definecolor{empatecolor}{RGB}{255,255,100}\n"
-        "\\definecolor{calculocolor}{RGB}{100,255,255}\n"
-        "\n"
+    salida_append(latex, PREAMBULO_LATEX);
+    salida_append(latex, "\\csname endofdump\\endcsname\n");
+    salida_printf(latex,
         "\\title{Resultados del Método Simplex\\\\\n"
         "\\large Problema: \\textbf{%s}}\n"
         "\\author{\n"
@@ -247,8 +224,8 @@ static void generar_portada_latex(GString *latex, const char *nombre_problema) {
 }
 
 // Función para generar la explicación del algoritmo simplex
-static void generar_algoritmo_simplex_latex(GString *latex) {
-    g_string_append_printf(latex,
+static void generar_algoritmo_simplex_latex(Salida *latex) {
+    salida_printf(latex,
         "\\section{El Algoritmo Simplex}\n"
         "\n"
         "\\subsection{Historia}\n"
@@ -275,17 +252,17 @@ static void generar_algoritmo_simplex_latex(GString *latex) {
 }
 
 // Función para generar el problema original en LaTeX
-void generar_problema_original_latex(GString *latex, ProblemaInfo *info) {
-    g_string_append(latex, "\\section{Formulación del Problema}\n\n");
+void generar_problema_original_latex(Salida *latex, ProblemaInfo *info) {
+    salida_append(latex, "\\section{Formulación del Problema}\n\n");
     char *nombre_escape = escape_latex(info->nombre_problema);
-    g_string_append_printf(latex, "\\textbf{Problema:} %s\\\\\n", nombre_escape);
+    salida_printf(latex, "\\textbf{Problema:} %s\\\\\n", nombre_escape);
     g_free(nombre_escape);
-    g_string_append_printf(latex, "\\textbf{Tipo:} %s\\\\\n", (strcmp(info->tipo_problema, "MAX") == 0) ? "Maximización" : "Minimización");
-    g_string_append_printf(latex, "\\textbf{Número de variables:} %d\\\\\n", info->num_vars);
-    g_string_append_printf(latex, "\\textbf{Número de restricciones:} %d\n\n", info->num_rest);
-    g_string_append(latex, "\\subsection{Función Objetivo}\n");
-    g_string_append(latex, "\\[\n");
-    g_string_append_printf(latex, "%s Z = ", 
+    salida_printf(latex, "\\textbf{Tipo:} %s\\\\\n", (strcmp(info->tipo_problema, "MAX") == 0) ? "Maximización" : "Minimización");
+    salida_printf(latex, "\\textbf{Número de variables:} %d\\\\\n", info->num_vars);
+    salida_printf(latex, "\\textbf{Número de restricciones:} %d\n\n", info->num_rest);
+    salida_append(latex, "\\subsection{Función Objetivo}\n");
+    salida_append(latex, "\\[\n");
+    salida_printf(latex, "%s Z = ", 
                           (strcmp(info->tipo_problema, "MAX") == 0) ? "Maximizar" : "Minimizar");
     
     int primer_coef = 1;
@@ -295,11 +272,11 @@ void generar_problema_original_latex(GString *latex, ProblemaInfo *info) {
             formatear_numero(info->coef_obj[i], num_buffer, sizeof(num_buffer));
             
             if (!primer_coef && info->coef_obj[i] >= 0) {
-                g_string_append(latex, " + ");
+                salida_append(latex, " + ");
             } else if (!primer_coef && info->coef_obj[i] < 0) {
-                g_string_append(latex, " - ");
+                salida_append(latex, " - ");
             } else if (primer_coef && info->coef_obj[i] < 0) {
-                g_string_append(latex, "-");
+                salida_append(latex, "-");
             }
             
             char var_latex[64];
@@ -307,17 +284,17 @@ void generar_problema_original_latex(GString *latex, ProblemaInfo *info) {
             
             double coef_abs = fabs(info->coef_obj[i]);
             if (fabs(coef_abs - 1.0) > EPSILON) {
-                g_string_append_printf(latex, "%s%s", num_buffer, var_latex);
+                salida_printf(latex, "%s%s", num_buffer, var_latex);
             } else {
-                g_string_append_printf(latex, "%s", var_latex);
+                salida_printf(latex, "%s", var_latex);
             }
             primer_coef = 0;
         }
     }
-    g_string_append(latex, "\n\\]\n\n");
-    g_string_append(latex, "\\subsection{Restricciones}\n");
-    g_string_append(latex, "\\[\n");
-    g_string_append(latex, "\\begin{cases}\n");
+    salida_append(latex, "\n\\]\n\n");
+    salida_append(latex, "\\subsection{Restricciones}\n");
+    salida_append(latex, "\\[\n");
+    salida_append(latex, "\\begin{cases}\n");
 
     for (int r = 0; r < info->num_rest; r++) {
         primer_coef = 1;
@@ -327,11 +304,11 @@ void generar_problema_original_latex(GString *latex, ProblemaInfo *info) {
                 formatear_numero(info->coef_rest[r][i], num_buffer, sizeof(num_buffer));
                 
                 if (!primer_coef && info->coef_rest[r][i] >= 0) {
-                    g_string_append(latex, " + ");
+                    salida_append(latex, " + ");
                 } else if (!primer_coef && info->coef_rest[r][i] < 0) {
-                    g_string_append(latex, " - ");
+                    salida_append(latex, " - ");
                 } else if (primer_coef && info->coef_rest[r][i] < 0) {
-                    g_string_append(latex, "-");
+                    salida_append(latex, "-");
                 }
                 
                 char var_latex[64];
@@ -339,16 +316,16 @@ void generar_problema_original_latex(GString *latex, ProblemaInfo *info) {
                 
                 double coef_abs = fabs(info->coef_rest[r][i]);
                 if (fabs(coef_abs - 1.0) > EPSILON) {
-                    g_string_append_printf(latex, "%s%s", num_buffer, var_latex);
+                    salida_printf(latex, "%s%s", num_buffer, var_latex);
                 } else {
-                    g_string_append_printf(latex, "%s", var_latex);
+                    salida_printf(latex, "%s", var_latex);
                 }
                 primer_coef = 0;
             }
         }
         
         if (primer_coef) {
-            g_string_append(latex, "0");
+            salida_append(latex, "0");
         }
         
         char rhs_buffer[32];
@@ -370,26 +347,26 @@ void generar_problema_original_latex(GString *latex, ProblemaInfo *info) {
                 break;
         }
         
-        g_string_append_printf(latex, " %s %s", simbolo, rhs_buffer);
+        salida_printf(latex, " %s %s", simbolo, rhs_buffer);
         
         if (r < info->num_rest - 1) {
-            g_string_append(latex, " \\\\\n");
+            salida_append(latex, " \\\\\n");
         }
     }
 
-    g_string_append(latex, "\n\\end{cases}\n");
-    g_string_append(latex, "\\]\n\n");
-    g_string_append(latex, "\\subsection{Restricciones de No Negatividad}\n");
-    g_string_append(latex, "\\[\n");
+    salida_append(latex, "\n\\end{cases}\n");
+    salida_append(latex, "\\]\n\n");
+    salida_append(latex, "\\subsection{Restricciones de No Negatividad}\n");
+    salida_append(latex, "\\[\n");
     for (int i = 0; i < info->num_vars; i++) {
         char var_latex[64];
         formatear_nombre_variable_latex(info->nombres_vars[i], var_latex, sizeof(var_latex));
-        g_string_append_printf(latex, "%s \\geq 0", var_latex);
+        salida_printf(latex, "%s \\geq 0", var_latex);
         if (i < info->num_vars - 1) {
-            g_string_append(latex, ", \\quad ");
+            salida_append(latex, ", \\quad ");
         }
     }
-    g_string_append(latex, "\n\\]\n\n");
+    salida_append(latex, "\n\\]\n\n");
 }
 
 // Función para determinar si una variable es básica
@@ -403,7 +380,7 @@ static gboolean es_variable_basica(TablaSimplex *tabla, int indice_variable) {
 }
 
 // Función para generar información de pivote
-static InfoPivote* calcular_info_pivote(TablaSimplex *tabla_actual, TablaSimplex *tabla_siguiente) {
+InfoPivote* calcular_info_pivote(TablaSimplex *tabla_actual, TablaSimplex *tabla_siguiente) {
     InfoPivote *info = g_new0(InfoPivote, 1);
     if (!tabla_actual || !tabla_siguiente) return info;
     for (int j = 0; j < tabla_actual->columnas - 1; j++) {
@@ -412,7 +389,7 @@ static InfoPivote* calcular_info_pivote(TablaSimplex *tabla_actual, TablaSimplex
         
         if (!en_base_actual && en_base_siguiente) {
             info->columna_pivote = j;
-            info->variable_entra = g_strdup(tabla_actual->nombres_vars[j]);
+            info->variable_entra = obtener_nombre_variable(tabla_actual, j);
             break;
         }
     }
@@ -430,7 +407,7 @@ static InfoPivote* calcular_info_pivote(TablaSimplex *tabla_actual, TablaSimplex
         
         if (!encontrada) {
             info->fila_pivote = i + 1; // +1 porque fila 0 es Z
-            info->variable_sale = g_strdup(tabla_actual->nombres_vars[var_base_actual]);
+            info->variable_sale = obtener_nombre_variable(tabla_actual, var_base_actual);
             break;
         }
     }
@@ -442,133 +419,164 @@ static InfoPivote* calcular_info_pivote(TablaSimplex *tabla_actual, TablaSimplex
     return info;
 }
 
-// Función para generar una tabla simplex en LaTeX 
-void generar_tabla_latex(GString *latex, TablaSimplex *tabla, const char *titulo, int iteracion, 
-                        gboolean es_final, InfoPivote *info_pivote) {
+void liberar_info_pivote(InfoPivote *info) {
+    if (!info) return;
+    g_free(info->razones);
+    g_free(info->filas_empate);
+    g_free(info);
+}
+
+// Función para escribir un valor de la fila Z, con los múltiplos de M en forma simbólica
+static void escribir_valor_z(Salida *latex, double valor) {
+    char num_buffer[FORMATO_TAM_BUFER];
+    gsize largo = formato_valor_gran_m(valor, M_GRANDE, EPSILON, num_buffer, sizeof(num_buffer));
+    salida_append_len(latex, num_buffer, MIN(largo, sizeof(num_buffer) - 1));
+}
+
+// Función para elegir las columnas de variables que se muestran de una tabla.
+// Devuelve NULL si caben todas; si no, solo las básicas y la que entra, en su orden.
+int* ventana_columnas_reporte(TablaSimplex *tabla, const OpcionesReporte *opciones, int columna_entra, int *num_columnas) {
+    int total = tabla->columnas - 1;
+    if (!opciones || opciones->max_columnas <= 0 || total <= opciones->max_columnas) {
+        return NULL;
+    }
+    
+    gboolean *visible = g_new0(gboolean, total);
+    for (int i = 0; i < tabla->num_restricciones; i++) {
+        int var_base = tabla->variables_base[i];
+        if (var_base >= 0 && var_base < total) {
+            visible[var_base] = TRUE;
+        }
+    }
+    if (columna_entra >= 0 && columna_entra < total) {
+        visible[columna_entra] = TRUE;
+    }
+    
+    int *columnas = g_new(int, total);
+    int n = 0;
+    for (int j = 0; j < total; j++) {
+        if (visible[j]) columnas[n++] = j;
+    }
+    g_free(visible);
+    
+    *num_columnas = n;
+    return columnas;
+}
+
+// Genera la tabla mostrando solo las columnas indicadas (todas si columnas es NULL)
+static void generar_tabla_latex_ventana(Salida *latex, TablaSimplex *tabla, const char *titulo, int iteracion,
+                                        gboolean es_final, InfoPivote *info_pivote,
+                                        const int *columnas, int num_columnas) {
     if (!tabla || !tabla->tabla) return;
     char var_entra_latex[64], var_sale_latex[64];
-    g_string_append_printf(latex, "\\subsection{%s}\n\n", titulo);
+    int mostradas = columnas ? num_columnas : tabla->columnas - 1;
+    int col_b = tabla->columnas - 1;
+    
+    salida_printf(latex, "\\subsection{%s}\n\n", titulo);
     if (iteracion >= 0) {
-        g_string_append_printf(latex, "\\textbf{Iteración:} %d\\\\\n", iteracion);
+        salida_printf(latex, "\\textbf{Iteración:} %d\\\\\n", iteracion);
     }
     
-    g_string_append(latex, "\\textbf{Variables básicas:} ");
+    salida_append(latex, "\\textbf{Variables básicas:} ");
     for (int i = 0; i < tabla->num_restricciones; i++) {
         int var_base = tabla->variables_base[i];
         char var_latex[64];
-        formatear_nombre_variable_latex(tabla->nombres_vars[var_base], var_latex, sizeof(var_latex));
-        g_string_append_printf(latex, "$%s$", var_latex);
+        formatear_nombre_variable_latex(obtener_nombre_variable(tabla, var_base), var_latex, sizeof(var_latex));
+        salida_printf(latex, "$%s$", var_latex);
         if (i < tabla->num_restricciones - 1) {
-            g_string_append(latex, ", ");
+            salida_append(latex, ", ");
         }
     }
-    g_string_append(latex, "\\\\\n");
+    salida_append(latex, "\\\\\n");
     
     if (info_pivote && info_pivote->columna_pivote >= 0) {
-        g_string_append(latex, "\\textbf{Variable que entra:} $");
+        salida_append(latex, "\\textbf{Variable que entra:} $");
         formatear_nombre_variable_latex(info_pivote->variable_entra, var_entra_latex, sizeof(var_entra_latex));
-        g_string_append_printf(latex, "%s$\\\\\n", var_entra_latex);
+        salida_printf(latex, "%s$\\\\\n", var_entra_latex);
         
         mostrar_calculos_pivote(latex, tabla, info_pivote->columna_pivote);
     }
     
     if (info_pivote && info_pivote->variable_entra && info_pivote->variable_sale) {
-        g_string_append(latex, "\\textbf{Operación de pivote:}\n");
-        g_string_append(latex, "\\begin{itemize}\n");
+        salida_append(latex, "\\textbf{Operación de pivote:}\n");
+        salida_append(latex, "\\begin{itemize}\n");
         
         formatear_nombre_variable_latex(info_pivote->variable_entra, var_entra_latex, sizeof(var_entra_latex));
         formatear_nombre_variable_latex(info_pivote->variable_sale, var_sale_latex, sizeof(var_sale_latex));
-        g_string_append_printf(latex, "\\item \\textcolor{entracolor}{\\textbf{Variable que entra:}} $%s$\n", var_entra_latex);
-        g_string_append_printf(latex, "\\item \\textcolor{salecolor}{\\textbf{Variable que sale:}} $%s$\n", var_sale_latex);
+        salida_printf(latex, "\\item \\textcolor{entracolor}{\\textbf{Variable que entra:}} $%s$\n", var_entra_latex);
+        salida_printf(latex, "\\item \\textcolor{salecolor}{\\textbf{Variable que sale:}} $%s$\n", var_sale_latex);
         
         char pivote_buffer[32];
         formatear_numero(info_pivote->valor_pivote, pivote_buffer, sizeof(pivote_buffer)); // Usar número normal
-        g_string_append_printf(latex, "\\item \\textcolor{pivotecolor}{\\textbf{Elemento pivote:}} $%s$\n", pivote_buffer);
-        g_string_append_printf(latex, "\\item \\textbf{Posición:} Fila %d, Columna %d\n", 
+        salida_printf(latex, "\\item \\textcolor{pivotecolor}{\\textbf{Elemento pivote:}} $%s$\n", pivote_buffer);
+        salida_printf(latex, "\\item \\textbf{Posición:} Fila %d, Columna %d\n", 
                               info_pivote->fila_pivote, info_pivote->columna_pivote + 1);
         
-        g_string_append(latex, "\\end{itemize}\n");
+        salida_append(latex, "\\end{itemize}\n");
     }
     
-    g_string_append(latex, "\n");
-    g_string_append(latex, "\\begin{center}\n");
-    g_string_append(latex, "\\small\n");
-    g_string_append(latex, "\\begin{tabular}{|c|");
+    salida_append(latex, "\n");
+    salida_append(latex, "\\begin{center}\n");
+    salida_append(latex, "\\small\n");
+    salida_append(latex, "\\begin{tabular}{|c|");
     
-    for (int j = 0; j < tabla->columnas - 1; j++) {
-        g_string_append(latex, "c|");
+    for (int k = 0; k < mostradas; k++) {
+        salida_append(latex, "c|");
     }
-    g_string_append(latex, "c|}\n");
-    g_string_append(latex, "\\hline\n");
-    g_string_append(latex, "\\textbf{Base} & ");
-    for (int j = 0; j < tabla->columnas - 1; j++) {
+    salida_append(latex, "c|}\n");
+    salida_append(latex, "\\hline\n");
+    salida_append(latex, "\\textbf{Base} & ");
+    for (int k = 0; k < mostradas; k++) {
+        int j = columnas ? columnas[k] : k;
         char var_escape[64];
-        formatear_nombre_variable_tabla(tabla->nombres_vars[j], var_escape, sizeof(var_escape));
+        formatear_nombre_variable_tabla(obtener_nombre_variable(tabla, j), var_escape, sizeof(var_escape));
         
         if (info_pivote && j == info_pivote->columna_pivote) {
-            g_string_append_printf(latex, "\\cellcolor{entracolor}\\textbf{%s}", var_escape);
+            salida_printf(latex, "\\cellcolor{entracolor}\\textbf{%s}", var_escape);
         } else {
-            g_string_append_printf(latex, "\\textbf{%s}", var_escape);
+            salida_printf(latex, "\\textbf{%s}", var_escape);
         }
         
-        if (j < tabla->columnas - 2) {
-            g_string_append(latex, " & ");
+        if (k < mostradas - 1) {
+            salida_append(latex, " & ");
         }
     }
-    g_string_append(latex, " & \\textbf{b} \\\\\n");
-    g_string_append(latex, "\\hline\n");
+    salida_append(latex, " & \\textbf{b} \\\\\n");
+    salida_append(latex, "\\hline\n");
     
     // Fila Z
-    g_string_append(latex, "Z & ");
-    for (int j = 0; j < tabla->columnas; j++) {
-        double valor = tabla->tabla[0][j];
-        char num_buffer[32];
+    salida_append(latex, "Z & ");
+    for (int k = 0; k <= mostradas; k++) {
+        int j = k == mostradas ? col_b : (columnas ? columnas[k] : k);
         gboolean es_pivote = (info_pivote && 0 == info_pivote->fila_pivote && j == info_pivote->columna_pivote);
         gboolean es_columna_entra = (info_pivote && j == info_pivote->columna_pivote);
         if (es_pivote) {
-            g_string_append(latex, "\\cellcolor{pivotecolor}");
+            salida_append(latex, "\\cellcolor{pivotecolor}");
         } else if (es_columna_entra) {
-            g_string_append(latex, "\\cellcolor{entracolor}");
+            salida_append(latex, "\\cellcolor{entracolor}");
         }
         
-        if (fabs(valor) > M_GRANDE/10) {
-            double coef_m = valor / M_GRANDE;
-            if (fabs(coef_m - round(coef_m)) < EPSILON) {
-                if (fabs(coef_m - 1.0) < EPSILON) {
-                    g_string_append_printf(latex, "M");
-                } else if (fabs(coef_m + 1.0) < EPSILON) {
-                    g_string_append_printf(latex, "-M");
-                } else {
-                    g_string_append_printf(latex, "%.0fM", coef_m);
-                }
-            } else {
-                g_string_append_printf(latex, "%.1fM", coef_m);
-            }
-        } else if (fabs(valor) < EPSILON) {
-            g_string_append(latex, "0");
-        } else {
-            formatear_numero(valor, num_buffer, sizeof(num_buffer));
-            g_string_append_printf(latex, "%s", num_buffer);
-        }
+        escribir_valor_z(latex, tabla->tabla[0][j]);
         
-        if (j < tabla->columnas - 1) {
-            g_string_append(latex, " & ");
+        if (k < mostradas) {
+            salida_append(latex, " & ");
         }
     }
-    g_string_append(latex, " \\\\\n");
-    g_string_append(latex, "\\hline\n");
+    salida_append(latex, " \\\\\n");
+    salida_append(latex, "\\hline\n");
     
     for (int i = 1; i < tabla->filas; i++) {
         int var_base = tabla->variables_base[i - 1];
         char var_base_escape[64];
-        formatear_nombre_variable_tabla(tabla->nombres_vars[var_base], var_base_escape, sizeof(var_base_escape));
+        formatear_nombre_variable_tabla(obtener_nombre_variable(tabla, var_base), var_base_escape, sizeof(var_base_escape));
         if (info_pivote && i == info_pivote->fila_pivote) {
-            g_string_append_printf(latex, "\\cellcolor{salecolor}%s & ", var_base_escape);
+            salida_printf(latex, "\\cellcolor{salecolor}%s & ", var_base_escape);
         } else {
-            g_string_append_printf(latex, "%s & ", var_base_escape);
+            salida_printf(latex, "%s & ", var_base_escape);
         }
         
-        for (int j = 0; j < tabla->columnas; j++) {
+        for (int k = 0; k <= mostradas; k++) {
+            int j = k == mostradas ? col_b : (columnas ? columnas[k] : k);
             double valor = tabla->tabla[i][j];
             char num_buffer[32];
             
@@ -577,66 +585,104 @@ void generar_tabla_latex(GString *latex, TablaSimplex *tabla, const char *titulo
             gboolean es_fila_sale = (info_pivote && i == info_pivote->fila_pivote);
             
             if (es_pivote) {
-                g_string_append(latex, "\\cellcolor{pivotecolor}");
+                salida_append(latex, "\\cellcolor{pivotecolor}");
             } else if (es_columna_entra) {
-                g_string_append(latex, "\\cellcolor{entracolor}");
+                salida_append(latex, "\\cellcolor{entracolor}");
             } else if (es_fila_sale) {
-                g_string_append(latex, "\\cellcolor{salecolor}");
+                salida_append(latex, "\\cellcolor{salecolor}");
             }
             
             if (fabs(valor) < EPSILON) {
-                g_string_append(latex, "0");
+                salida_append(latex, "0");
             } else {
                 formatear_numero(valor, num_buffer, sizeof(num_buffer));
-                g_string_append_printf(latex, "%s", num_buffer);
+                salida_printf(latex, "%s", num_buffer);
             }
             
-            if (j < tabla->columnas - 1) {
-                g_string_append(latex, " & ");
+            if (k < mostradas) {
+                salida_append(latex, " & ");
             }
         }
-        g_string_append(latex, " \\\\\n");
-        g_string_append(latex, "\\hline\n");
+        salida_append(latex, " \\\\\n");
+        salida_append(latex, "\\hline\n");
+    }
+    salida_append(latex, "\\end{tabular}\n");
+    salida_append(latex, "\\end{center}\n\n");
+    if (columnas) {
+        salida_printf(latex, "\\textit{Por el tamaño del problema se omiten %d columnas no básicas.}\\\\\n\n",
+                              tabla->columnas - 1 - num_columnas);
     }
-    g_string_append(latex, "\\end{tabular}\n");
-    g_string_append(latex, "\\end{center}\n\n");
     if (info_pivote) {
-        g_string_append(latex, "\\vspace{0.2cm}\n");
-        g_string_append(latex, "\\textbf{Significado de colores:}\n");
-        g_string_append(latex, "\\begin{itemize}\\small\n");
-        g_string_append(latex, "\\item \\textcolor{entracolor}{\\blacksquare} Variable que entra\n");
-        g_string_append(latex, "\\item \\textcolor{salecolor}{\\blacksquare} Variable que sale\n");
-        g_string_append(latex, "\\item \\textcolor{pivotecolor}{\\blacksquare} Elemento pivote\n");
-        g_string_append(latex, "\\end{itemize}\n");
+        salida_append(latex, "\\vspace{0.2cm}\n");
+        salida_append(latex, "\\textbf{Significado de colores:}\n");
+        salida_append(latex, "\\begin{itemize}\\small\n");
+        salida_append(latex, "\\item \\textcolor{entracolor}{$\\blacksquare$} Variable que entra\n");
+        salida_append(latex, "\\item \\textcolor{salecolor}{$\\blacksquare$} Variable que sale\n");
+        salida_append(latex, "\\item \\textcolor{pivotecolor}{$\\blacksquare$} Elemento pivote\n");
+        salida_append(latex, "\\end{itemize}\n");
     }
     
     if (es_final) {
         double *solucion = g_new0(double, tabla->num_vars_decision);
         extraer_solucion(tabla, solucion);
         
-        g_string_append(latex, "\\textbf{Solución:}\n");
-        g_string_append(latex, "\\begin{align*}\n");
+        salida_append(latex, "\\textbf{Solución:}\n");
+        salida_append(latex, "\\begin{align*}\n");
         for (int i = 0; i < tabla->num_vars_decision; i++) {
             char var_latex[64];
-            formatear_nombre_variable_latex(tabla->nombres_vars[i], var_latex, sizeof(var_latex));
+            formatear_nombre_variable_latex(obtener_nombre_variable(tabla, i), var_latex, sizeof(var_latex));
             char num_buffer[32];
             formatear_numero(solucion[i], num_buffer, sizeof(num_buffer));
-            g_string_append_printf(latex, "%s &= %s", var_latex, num_buffer);
+            salida_printf(latex, "%s &= %s", var_latex, num_buffer);
             if (i < tabla->num_vars_decision - 1) {
-                g_string_append(latex, " \\\\\n");
+                salida_append(latex, " \\\\\n");
             }
         }
-        g_string_append(latex, "\n\\end{align*}\n\n");
+        salida_append(latex, "\n\\end{align*}\n\n");
         
         g_free(solucion);
     }
 }
 
+// Función para generar una tabla simplex en LaTeX 
+void generar_tabla_latex(Salida *latex, TablaSimplex *tabla, const char *titulo, int iteracion, 
+                        gboolean es_final, InfoPivote *info_pivote) {
+    generar_tabla_latex_ventana(latex, tabla, titulo, iteracion, es_final, info_pivote, NULL, 0);
+}
+
+// Igual que generar_tabla_latex, pero recortando las columnas según las opciones del reporte
+static void generar_tabla_latex_opciones(Salida *latex, TablaSimplex *tabla, const char *titulo, int iteracion,
+                                         gboolean es_final, InfoPivote *info_pivote, const OpcionesReporte *opciones) {
+    if (!tabla || !tabla->tabla) return;
+    int num_columnas = 0;
+    int *columnas = ventana_columnas_reporte(tabla, opciones, info_pivote ? info_pivote->columna_pivote : -1, &num_columnas);
+    generar_tabla_latex_ventana(latex, tabla, titulo, iteracion, es_final, info_pivote, columnas, num_columnas);
+    g_free(columnas);
+}
+
+// Función para resumir en una línea una iteración: qué entra, qué sale y cómo queda Z
+static void generar_resumen_iteracion_latex(Salida *latex, TablaSimplex *siguiente, int iteracion,
+                                            InfoPivote *info_pivote) {
+    char var_entra_latex[64], var_sale_latex[64], pivote_buffer[32];
+    
+    salida_printf(latex, "\\item Iteración %d: ", iteracion);
+    if (info_pivote->variable_entra && info_pivote->variable_sale) {
+        formatear_nombre_variable_latex(info_pivote->variable_entra, var_entra_latex, sizeof(var_entra_latex));
+        formatear_nombre_variable_latex(info_pivote->variable_sale, var_sale_latex, sizeof(var_sale_latex));
+        formatear_numero(info_pivote->valor_pivote, pivote_buffer, sizeof(pivote_buffer));
+        salida_printf(latex, "entra $%s$, sale $%s$ (fila %d), pivote $%s$, ",
+                              var_entra_latex, var_sale_latex, info_pivote->fila_pivote, pivote_buffer);
+    }
+    salida_append(latex, "$Z = ");
+    escribir_valor_z(latex, siguiente->tabla[0][siguiente->columnas - 1]);
+    salida_append(latex, "$\n");
+}
+
 // Función para generar la tabla inicial simplex 
-void generar_tabla_uno_latex(GString *latex, ProblemaInfo *info) {
+void generar_tabla_uno_latex(Salida *latex, ProblemaInfo *info) {
     if (!info) return;
     
-    g_string_append(latex, "\\section{Tabla Simplex Inicial}\n\n");
+    salida_append(latex, "\\section{Tabla Simplex Inicial}\n\n");
     
     // Calcular número total de columnas (variables + holgura + artificiales)
     int total_vars = info->num_vars;
@@ -662,97 +708,97 @@ void generar_tabla_uno_latex(GString *latex, ProblemaInfo *info) {
     
     int total_columnas = total_vars + total_holgura + total_exceso + total_artificiales;
     
-    g_string_append(latex, "\\begin{center}\n");
-    g_string_append(latex, "\\small\n");
-    g_string_append(latex, "\\begin{tabular}{|c|");
+    salida_append(latex, "\\begin{center}\n");
+    salida_append(latex, "\\small\n");
+    salida_append(latex, "\\begin{tabular}{|c|");
     
     // Encabezado de columnas para variables
     for (int j = 0; j < total_columnas; j++) {
-        g_string_append(latex, "c|");
+        salida_append(latex, "c|");
     }
-    g_string_append(latex, "c|}\n"); // Columna adicional para b al final
-    g_string_append(latex, "\\hline\n");
+    salida_append(latex, "c|}\n"); // Columna adicional para b al final
+    salida_append(latex, "\\hline\n");
     
     // Fila de encabezados - CORREGIDO: b al final
-    g_string_append(latex, "\\textbf{Z} & ");
+    salida_append(latex, "\\textbf{Z} & ");
     
     // Variables de decisión
     for (int j = 0; j < info->num_vars; j++) {
         char var_latex[64];
         formatear_nombre_variable_latex(info->nombres_vars[j], var_latex, sizeof(var_latex));
-        g_string_append_printf(latex, "\\textbf{$%s$}", var_latex);
-        g_string_append(latex, " & ");
+        salida_printf(latex, "\\textbf{$%s$}", var_latex);
+        salida_append(latex, " & ");
     }
     
     // Variables de holgura
     for (int i = 0; i < total_holgura; i++) {
-        g_string_append_printf(latex, "\\textbf{$s_%d$}", i + 1);
+        salida_printf(latex, "\\textbf{$s_%d$}", i + 1);
         if (i < total_holgura - 1 || total_exceso > 0 || total_artificiales > 0) {
-            g_string_append(latex, " & ");
+            salida_append(latex, " & ");
         }
     }
     
     // Variables de exceso
     for (int i = 0; i < total_exceso; i++) {
-        g_string_append_printf(latex, "\\textbf{$e_%d$}", i + 1);
+        salida_printf(latex, "\\textbf{$e_%d$}", i + 1);
         if (i < total_exceso - 1 || total_artificiales > 0) {
-            g_string_append(latex, " & ");
+            salida_append(latex, " & ");
         }
     }
     
     // Variables artificiales
     for (int i = 0; i < total_artificiales; i++) {
-        g_string_append_printf(latex, "\\textbf{$a_%d$}", i + 1);
+        salida_printf(latex, "\\textbf{$a_%d$}", i + 1);
         if (i < total_artificiales - 1) {
-            g_string_append(latex, " & ");
+            salida_append(latex, " & ");
         }
     }
     
-    g_string_append(latex, " & \\textbf{b} \\\\\n");
-    g_string_append(latex, "\\hline\n");
+    salida_append(latex, " & \\textbf{b} \\\\\n");
+    salida_append(latex, "\\hline\n");
     
     // Fila Z (función objetivo) - CORREGIDO: b al final
-    g_string_append(latex, "1 & ");
+    salida_append(latex, "1 & ");
     
     // Coeficientes de variables en Z
     for (int j = 0; j < info->num_vars; j++) {
         char num_buffer[32];
         double coef = -info->coef_obj[j]; // Negativo porque en simplex se pasa al lado izquierdo
         formatear_numero(coef, num_buffer, sizeof(num_buffer));
-        g_string_append_printf(latex, "%s", num_buffer);
-        g_string_append(latex, " & ");
+        salida_printf(latex, "%s", num_buffer);
+        salida_append(latex, " & ");
     }
     
     // Coeficientes cero para variables de holgura en Z
     for (int i = 0; i < total_holgura; i++) {
-        g_string_append(latex, "0");
+        salida_append(latex, "0");
         if (i < total_holgura - 1 || total_exceso > 0 || total_artificiales > 0) {
-            g_string_append(latex, " & ");
+            salida_append(latex, " & ");
         }
     }
     
     // Coeficientes cero para variables de exceso en Z
     for (int i = 0; i < total_exceso; i++) {
-        g_string_append(latex, "0");
+        salida_append(latex, "0");
         if (i < total_exceso - 1 || total_artificiales > 0) {
-            g_string_append(latex, " & ");
+            salida_append(latex, " & ");
         }
     }
     
     // Coeficientes M para variables artificiales en Z
     for (int i = 0; i < total_artificiales; i++) {
         if (strcmp(info->tipo_problema, "MAX") == 0) {
-            g_string_append(latex, "-M");
+            salida_append(latex, "-M");
         } else {
-            g_string_append(latex, "M");
+            salida_append(latex, "M");
         }
         if (i < total_artificiales - 1) {
-            g_string_append(latex, " & ");
+            salida_append(latex, " & ");
         }
     }
     
-    g_string_append(latex, " & 0 \\\\\n");
-    g_string_append(latex, "\\hline\n");
+    salida_append(latex, " & 0 \\\\\n");
+    salida_append(latex, "\\hline\n");
     
     // Restricciones
     int cont_holgura = 0;
@@ -763,15 +809,15 @@ void generar_tabla_uno_latex(GString *latex, ProblemaInfo *info) {
         // Variable básica
         switch (info->tipos_restricciones[r]) {
             case RESTRICCION_LE:
-                g_string_append_printf(latex, "$s_%d$ & ", cont_holgura + 1);
+                salida_printf(latex, "$s_%d$ & ", cont_holgura + 1);
                 cont_holgura++;
                 break;
             case RESTRICCION_GE:
-                g_string_append_printf(latex, "$a_%d$ & ", cont_artificial + 1);
+                salida_printf(latex, "$a_%d$ & ", cont_artificial + 1);
                 cont_artificial++;
                 break;
             case RESTRICCION_EQ:
-                g_string_append_printf(latex, "$a_%d$ & ", cont_artificial + 1);
+                salida_printf(latex, "$a_%d$ & ", cont_artificial + 1);
                 cont_artificial++;
                 break;
         }
@@ -780,31 +826,31 @@ void generar_tabla_uno_latex(GString *latex, ProblemaInfo *info) {
         for (int j = 0; j < info->num_vars; j++) {
             char num_buffer[32];
             formatear_numero(info->coef_rest[r][j], num_buffer, sizeof(num_buffer));
-            g_string_append_printf(latex, "%s", num_buffer);
-            g_string_append(latex, " & ");
+            salida_printf(latex, "%s", num_buffer);
+            salida_append(latex, " & ");
         }
         
         // Variables de holgura
         for (int i = 0; i < total_holgura; i++) {
             if (info->tipos_restricciones[r] == RESTRICCION_LE && i == cont_holgura - 1) {
-                g_string_append(latex, "1");
+                salida_append(latex, "1");
             } else {
-                g_string_append(latex, "0");
+                salida_append(latex, "0");
             }
             if (i < total_holgura - 1 || total_exceso > 0 || total_artificiales > 0) {
-                g_string_append(latex, " & ");
+                salida_append(latex, " & ");
             }
         }
         
         // Variables de exceso
         for (int i = 0; i < total_exceso; i++) {
             if (info->tipos_restricciones[r] == RESTRICCION_GE && i == cont_exceso) {
-                g_string_append(latex, "-1");
+                salida_append(latex, "-1");
             } else {
-                g_string_append(latex, "0");
+                salida_append(latex, "0");
             }
             if (i < total_exceso - 1 || total_artificiales > 0) {
-                g_string_append(latex, " & ");
+                salida_append(latex, " & ");
             }
         }
         if (info->tipos_restricciones[r] == RESTRICCION_GE) {
@@ -815,161 +861,294 @@ void generar_tabla_uno_latex(GString *latex, ProblemaInfo *info) {
         for (int i = 0; i < total_artificiales; i++) {
             if ((info->tipos_restricciones[r] == RESTRICCION_GE || 
                  info->tipos_restricciones[r] == RESTRICCION_EQ) && i == cont_artificial - 1) {
-                g_string_append(latex, "1");
+                salida_append(latex, "1");
             } else {
-                g_string_append(latex, "0");
+                salida_append(latex, "0");
             }
             if (i < total_artificiales - 1) {
-                g_string_append(latex, " & ");
+                salida_append(latex, " & ");
             }
         }
         
         // Lado derecho (b) al final
         char b_buffer[32];
         formatear_numero(info->lados_derechos[r], b_buffer, sizeof(b_buffer));
-        g_string_append_printf(latex, " & %s \\\\\n", b_buffer);
-        g_string_append(latex, "\\hline\n");
+        salida_printf(latex, " & %s \\\\\n", b_buffer);
+        salida_append(latex, "\\hline\n");
     }
     
-    g_string_append(latex, "\\end{tabular}\n");
-    g_string_append(latex, "\\end{center}\n\n");
+    salida_append(latex, "\\end{tabular}\n");
+    salida_append(latex, "\\end{center}\n\n");
     
     // Leyenda explicativa
-    g_string_append(latex, "\\textbf{Explicación de la tabla inicial:}\n");
-    g_string_append(latex, "\\begin{itemize}\\small\n");
+    salida_append(latex, "\\textbf{Explicación de la tabla inicial:}\n");
+    salida_append(latex, "\\begin{itemize}\\small\n");
     
-    g_string_append(latex, "\\item \\textbf{Variables básicas iniciales:} ");
+    salida_append(latex, "\\item \\textbf{Variables básicas iniciales:} ");
     
     cont_holgura = 0;
     cont_artificial = 0;
     int primera = 1;
     for (int r = 0; r < info->num_rest; r++) {
-        if (!primera) g_string_append(latex, ", ");
+        if (!primera) salida_append(latex, ", ");
         switch (info->tipos_restricciones[r]) {
             case RESTRICCION_LE:
-                g_string_append_printf(latex, "$s_%d$", ++cont_holgura);
+                salida_printf(latex, "$s_%d$", ++cont_holgura);
                 break;
             case RESTRICCION_GE:
             case RESTRICCION_EQ:
-                g_string_append_printf(latex, "$a_%d$", ++cont_artificial);
+                salida_printf(latex, "$a_%d$", ++cont_artificial);
                 break;
         }
         primera = 0;
     }
-    g_string_append(latex, "\n");
+    salida_append(latex, "\n");
     
     if (total_artificiales > 0) {
-        g_string_append(latex, "\\item \\textbf{Método de la Gran M:} Se utilizan variables artificiales ");
-        g_string_append(latex, "para restricciones $\\geq$ y $=$\n");
-        g_string_append_printf(latex, "\\item \\textbf{Valor de M:} $%.0f$\n", M_GRANDE);
+        salida_append(latex, "\\item \\textbf{Método de la Gran M:} Se utilizan variables artificiales ");
+        salida_append(latex, "para restricciones $\\geq$ y $=$\n");
+        salida_printf(latex, "\\item \\textbf{Valor de M:} $%.0f$\n", M_GRANDE);
     }
     
-    g_string_append(latex, "\\item \\textbf{Fila Z:} Muestra los coeficientes reducidos ");
-    g_string_append(latex, "(costo de oportunidad)\n");
-    g_string_append(latex, "\\item \\textbf{Columna b:} Términos independientes de las restricciones (al final)\n");
-    g_string_append(latex, "\\end{itemize}\n\n");
+    salida_append(latex, "\\item \\textbf{Fila Z:} Muestra los coeficientes reducidos ");
+    salida_append(latex, "(costo de oportunidad)\n");
+    salida_append(latex, "\\item \\textbf{Columna b:} Términos independientes de las restricciones (al final)\n");
+    salida_append(latex, "\\end{itemize}\n\n");
 }
 
 // Generar tabla inicial
-void generar_tabla_inicial_latex(GString *latex, TablaSimplex *tabla, ProblemaInfo *info) {
-    generar_tabla_uno_latex(latex, info);
-    generar_tabla_latex(latex, tabla, "Tabla Inicial del Método Simplex", -1, FALSE, NULL);
+void generar_tabla_inicial_latex(Salida *latex, TablaSimplex *tabla, ProblemaInfo *info,
+                                 const OpcionesReporte *opciones) {
+    int num_columnas = 0;
+    int *columnas = ventana_columnas_reporte(tabla, opciones, -1, &num_columnas);
+    if (columnas) {
+        // La tabla completa no cabe: se omite la versión desarrollada y se muestra la ventana
+        salida_append(latex, "\\section{Tabla Simplex Inicial}\n\n");
+        salida_printf(latex, "La tabla inicial tiene %d columnas de variables; por su tamaño ", tabla->columnas - 1);
+        salida_append(latex, "en las tablas se muestran solo las variables básicas y la que entra.\n\n");
+    } else {
+        generar_tabla_uno_latex(latex, info);
+    }
+    generar_tabla_latex_ventana(latex, tabla, "Tabla Inicial del Método Simplex", -1, FALSE, NULL, columnas, num_columnas);
+    g_free(columnas);
     if (tabla->num_vars_artificiales > 0) {
-        g_string_append(latex, "\\textbf{Nota:} Se utilizó el método de la Gran M con ");
-        g_string_append_printf(latex, "$M = %.0f$\\\\\n", M_GRANDE);
-        g_string_append(latex, "\\textbf{Variables artificiales:} ");
+        salida_append(latex, "\\textbf{Nota:} Se utilizó el método de la Gran M con ");
+        salida_printf(latex, "$M = %.0f$\\\\\n", M_GRANDE);
+        salida_append(latex, "\\textbf{Variables artificiales:} ");
         
         int primera = 1;
         for (int i = tabla->num_vars_decision + tabla->num_vars_holgura + tabla->num_vars_exceso;
              i < tabla->num_vars_decision + tabla->num_vars_holgura + 
                  tabla->num_vars_exceso + tabla->num_vars_artificiales; i++) {
-            if (!primera) g_string_append(latex, ", ");
+            if (!primera) salida_append(latex, ", ");
             char var_latex[64];
-            formatear_nombre_variable_latex(tabla->nombres_vars[i], var_latex, sizeof(var_latex));
-            g_string_append_printf(latex, "$%s$", var_latex);
+            formatear_nombre_variable_latex(obtener_nombre_variable(tabla, i), var_latex, sizeof(var_latex));
+            salida_printf(latex, "$%s$", var_latex);
             primera = 0;
         }
-        g_string_append(latex, "\\\\\n\n");
+        salida_append(latex, "\\\\\n\n");
     }
 }
 
-// Función para generar tablas intermedias 
-void generar_tablas_intermedias_latex(GString *latex, TablaSimplex **tablas, int num_tablas, 
-                                     ProblemaInfo *info, ResultadoSimplex *resultado) {
-    if (!tablas || num_tablas <= 1) return;
-    g_string_append(latex, "\\section{Iteraciones del Método Simplex}\n\n");
-    for (int i = 1; i < num_tablas - 1; i++) {
-        InfoPivote *info_pivote = calcular_info_pivote(tablas[i-1], tablas[i]);
+// Iteraciones a partir de las cuales conviene repartir el trabajo entre hilos
+#define MIN_ITERACIONES_PARALELAS 8
+// Iteraciones en vuelo por hilo: acota la memoria de los textos pendientes de escribir
+#define ITERACIONES_POR_HILO 4
+
+// Una iteración va resumida si queda fuera de las primeras y las últimas K
+static gboolean iteracion_resumida(int i, int num_iteraciones, int completas) {
+    return completas > 0 && i > completas && i <= num_iteraciones - completas;
+}
+
+// Función para generar una iteración: su tabla con el pivote, o su línea de resumen.
+// Abre y cierra la lista del resumen según la vecindad, así que solo depende de 'i'
+// y se puede generar en cualquier orden.
+static void generar_iteracion_latex(Salida *latex, TablaSimplex **tablas, int i, int num_iteraciones,
+                                    const OpcionesReporte *opciones) {
+    int completas = opciones ? opciones->iteraciones_completas : 0;
+    gboolean resumida = iteracion_resumida(i, num_iteraciones, completas);
+    gboolean anterior_resumida = iteracion_resumida(i - 1, num_iteraciones, completas);
+    InfoPivote *info_pivote = calcular_info_pivote(tablas[i-1], tablas[i]);
+    
+    if (resumida) {
+        if (!anterior_resumida) {
+            salida_printf(latex, "\\subsection{Iteraciones %d a %d (resumen)}\n\n",
+                                  i, num_iteraciones - completas);
+            salida_append(latex, "\\begin{itemize}\\small\n");
+        }
+        generar_resumen_iteracion_latex(latex, tablas[i], i, info_pivote);
+    } else {
+        if (anterior_resumida) {
+            salida_append(latex, "\\end{itemize}\n\n");
+        }
         if (info_pivote) {
             InfoPivote info_con_calculos = *info_pivote;
-            generar_tabla_latex(latex, tablas[i-1], "Tabla Intermedia", i, FALSE, &info_con_calculos);
+            generar_tabla_latex_opciones(latex, tablas[i-1], "Tabla Intermedia", i, FALSE, &info_con_calculos, opciones);
         } else {
-            generar_tabla_latex(latex, tablas[i], "Tabla Intermedia", i, FALSE, NULL);
+            generar_tabla_latex_opciones(latex, tablas[i], "Tabla Intermedia", i, FALSE, NULL, opciones);
+        }
+    }
+    
+    liberar_info_pivote(info_pivote);
+}
+
+// Lote de iteraciones que los hilos generan en memoria y luego se escribe en orden
+typedef struct {
+    TablaSimplex **tablas;
+    int num_iteraciones;
+    const OpcionesReporte *opciones;
+    int inicio;              // Primera iteración del lote
+    gchar **textos;          // Texto de cada iteración del lote
+    gsize *largos;
+    int pendientes;
+    GMutex mutex;
+    GCond terminado;
+} LoteIteraciones;
+
+static void generar_iteracion_en_lote(gpointer dato, gpointer datos_pool) {
+    LoteIteraciones *lote = datos_pool;
+    int i = GPOINTER_TO_INT(dato);
+    
+    Salida *memoria = salida_memoria();
+    generar_iteracion_latex(memoria, lote->tablas, i, lote->num_iteraciones, lote->opciones);
+    gsize largo = 0;
+    gchar *texto = salida_cerrar_memoria(memoria, &largo);
+    
+    g_mutex_lock(&lote->mutex);
+    lote->textos[i - lote->inicio] = texto;
+    lote->largos[i - lote->inicio] = largo;
+    if (--lote->pendientes == 0) {
+        g_cond_signal(&lote->terminado);
+    }
+    g_mutex_unlock(&lote->mutex);
+}
+
+// Genera las iteraciones en paralelo, por lotes. Devuelve FALSE si no se pudieron crear los hilos.
+static gboolean generar_iteraciones_paralelo(Salida *latex, TablaSimplex **tablas, int num_iteraciones,
+                                             const OpcionesReporte *opciones) {
+    int hilos = MIN((int)g_get_num_processors(), num_iteraciones);
+    if (hilos < 2) return FALSE;
+    
+    LoteIteraciones lote = { .tablas = tablas, .num_iteraciones = num_iteraciones, .opciones = opciones };
+    GThreadPool *pool = g_thread_pool_new(generar_iteracion_en_lote, &lote, hilos, FALSE, NULL);
+    if (!pool) return FALSE;
+    
+    int tam_lote = hilos * ITERACIONES_POR_HILO;
+    lote.textos = g_new0(gchar*, tam_lote);
+    lote.largos = g_new0(gsize, tam_lote);
+    g_mutex_init(&lote.mutex);
+    g_cond_init(&lote.terminado);
+    
+    for (int inicio = 1; inicio <= num_iteraciones; inicio += tam_lote) {
+        int fin = MIN(inicio + tam_lote - 1, num_iteraciones);
+        
+        g_mutex_lock(&lote.mutex);
+        lote.inicio = inicio;
+        lote.pendientes = fin - inicio + 1;
+        g_mutex_unlock(&lote.mutex);
+        
+        for (int i = inicio; i <= fin; i++) {
+            g_thread_pool_push(pool, GINT_TO_POINTER(i), NULL);
         }
         
-        if (info_pivote) {
-            g_free(info_pivote->variable_entra);
-            g_free(info_pivote->variable_sale);
-            g_free(info_pivote->razones);
-            g_free(info_pivote->filas_empate);
-            g_free(info_pivote);
+        g_mutex_lock(&lote.mutex);
+        while (lote.pendientes > 0) {
+            g_cond_wait(&lote.terminado, &lote.mutex);
+        }
+        g_mutex_unlock(&lote.mutex);
+        
+        for (int i = inicio; i <= fin; i++) {
+            salida_append_len(latex, lote.textos[i - inicio], lote.largos[i - inicio]);
+            g_free(lote.textos[i - inicio]);
         }
     }
+    
+    g_thread_pool_free(pool, FALSE, TRUE);
+    g_mutex_clear(&lote.mutex);
+    g_cond_clear(&lote.terminado);
+    g_free(lote.textos);
+    g_free(lote.largos);
+    return TRUE;
+}
+
+// Función para generar tablas intermedias. Con opciones->iteraciones_completas = K solo
+// las primeras y las últimas K iteraciones van completas; las demás, en una línea cada una.
+// Con muchas iteraciones, cada una se genera en un hilo y se escriben en orden.
+void generar_tablas_intermedias_latex(Salida *latex, TablaSimplex **tablas, int num_tablas, 
+                                     ProblemaInfo *info, ResultadoSimplex *resultado,
+                                     const OpcionesReporte *opciones) {
+    if (!tablas || num_tablas <= 1) return;
+    int num_iteraciones = num_tablas - 2;
+    
+    salida_append(latex, "\\section{Iteraciones del Método Simplex}\n\n");
+    if (num_iteraciones >= MIN_ITERACIONES_PARALELAS &&
+        generar_iteraciones_paralelo(latex, tablas, num_iteraciones, opciones)) {
+        return;
+    }
+    
+    for (int i = 1; i <= num_iteraciones; i++) {
+        generar_iteracion_latex(latex, tablas, i, num_iteraciones, opciones);
+    }
 }
 // Función para generar la tabla final
-void generar_tabla_final_latex(GString *latex, ResultadoSimplex *resultado, ProblemaInfo *info) {
+void generar_tabla_final_latex(Salida *latex, ResultadoSimplex *resultado, ProblemaInfo *info,
+                               const OpcionesReporte *opciones) {
     if (!resultado || !resultado->tablas_intermedias || resultado->num_tablas == 0) return;
     
     TablaSimplex *tabla_final = resultado->tablas_intermedias[resultado->num_tablas - 1];
-    generar_tabla_latex(latex, tabla_final, "Tabla Final - Solución Óptima", -1, TRUE, NULL);
+    generar_tabla_latex_opciones(latex, tabla_final, "Tabla Final - Solución Óptima", -1, TRUE, NULL, opciones);
     
     switch (resultado->tipo_solucion) {
         case SOLUCION_OPTIMA:
             if (resultado->es_degenerado) {
-                g_string_append(latex, "\\textbf{Problema Degenerado:} Al menos una variable básica tiene valor cero.\\\\\n");
+                salida_append(latex, "\\textbf{Problema Degenerado:} Al menos una variable básica tiene valor cero.\\\\\n");
             }
             break;
             
         case SOLUCION_MULTIPLE:
-            g_string_append(latex, "\\textbf{Solución Múltiple:} Existen infinitas soluciones óptimas.\\\\\n");
+            salida_append(latex, "\\textbf{Solución Múltiple:} Existen infinitas soluciones óptimas.\\\\\n");
             break;
             
         case SOLUCION_NO_ACOTADA:
-            g_string_append(latex, "\\textbf{Problema No Acotado:} La función objetivo puede mejorar indefinidamente.\\\\\n");
+            salida_append(latex, "\\textbf{Problema No Acotado:} La función objetivo puede mejorar indefinidamente.\\\\\n");
             break;
             
         case SOLUCION_NO_FACTIBLE:
-            g_string_append(latex, "\\textbf{Problema No Factible:} No existe solución que satisfaga todas las restricciones.\\\\\n");
+            salida_append(latex, "\\textbf{Problema No Factible:} No existe solución que satisfaga todas las restricciones.\\\\\n");
+            break;
+            
+        case SOLUCION_INTERRUMPIDA:
+            salida_append(latex, "\\textbf{Resolución Interrumpida:} Esta es la última tabla alcanzada, no necesariamente óptima.\\\\\n");
             break;
     }
     
-    g_string_append(latex, "\n");
+    salida_append(latex, "\n");
 }
 
 // Función para generar solución múltiple
-void generar_solucion_multiple_latex(GString *latex, ResultadoSimplex *resultado, ProblemaInfo *info) {
+void generar_solucion_multiple_latex(Salida *latex, ResultadoSimplex *resultado, ProblemaInfo *info) {
     if (resultado->tipo_solucion != SOLUCION_MULTIPLE) return;
     
-    g_string_append(latex, "\\section{Solución Múltiple}\n\n");
-    g_string_append(latex, "El problema tiene infinitas soluciones óptimas.\\\\\n");
+    salida_append(latex, "\\section{Solución Múltiple}\n\n");
+    salida_append(latex, "El problema tiene infinitas soluciones óptimas.\\\\\n");
     
     if (resultado->segunda_tabla) {
-        g_string_append(latex, "\\subsection{Segunda Tabla Óptima}\n\n");
+        salida_append(latex, "\\subsection{Segunda Tabla Óptima}\n\n");
         generar_tabla_latex(latex, resultado->segunda_tabla, "Segunda Solución Básica Óptima", -1, TRUE, NULL);
     }
     
-    g_string_append(latex, "\\subsection{Explicación de Soluciones Múltiples}\n\n");
-    g_string_append(latex, "Cuando un problema de programación lineal tiene soluciones múltiples, significa que existe más de una combinación de valores para las variables de decisión que produce el mismo valor óptimo de la función objetivo.\n\n");
-    g_string_append(latex, "\\textbf{Condición para soluciones múltiples:}\n");
-    g_string_append(latex, "\\begin{itemize}\n");
-    g_string_append(latex, "\\item Al menos una variable no básica tiene coeficiente cero en la fila Z de la tabla óptima\n");
-    g_string_append(latex, "\\item Esto indica que podemos introducir esa variable en la base sin cambiar el valor de Z\n");
-    g_string_append(latex, "\\item El conjunto de soluciones óptimas forma un segmento de recta (en 2D) o un hiperplano (en nD)\n");
-    g_string_append(latex, "\\end{itemize}\n\n");
+    salida_append(latex, "\\subsection{Explicación de Soluciones Múltiples}\n\n");
+    salida_append(latex, "Cuando un problema de programación lineal tiene soluciones múltiples, significa que existe más de una combinación de valores para las variables de decisión que produce el mismo valor óptimo de la función objetivo.\n\n");
+    salida_append(latex, "\\textbf{Condición para soluciones múltiples:}\n");
+    salida_append(latex, "\\begin{itemize}\n");
+    salida_append(latex, "\\item Al menos una variable no básica tiene coeficiente cero en la fila Z de la tabla óptima\n");
+    salida_append(latex, "\\item Esto indica que podemos introducir esa variable en la base sin cambiar el valor de Z\n");
+    salida_append(latex, "\\item El conjunto de soluciones óptimas forma un segmento de recta (en 2D) o un hiperplano (en nD)\n");
+    salida_append(latex, "\\end{itemize}\n\n");
     
     if (resultado->soluciones_adicionales && resultado->num_soluciones_adicionales > 0) {
-        g_string_append(latex, "\\subsection{Soluciones Adicionales}\n\n");
-        g_string_append(latex, "A continuación se presentan soluciones adicionales obtenidas como combinaciones convexas de las dos soluciones básicas óptimas:\n\n");
+        salida_append(latex, "\\subsection{Soluciones Adicionales}\n\n");
+        salida_append(latex, "A continuación se presentan soluciones adicionales obtenidas como combinaciones convexas de las dos soluciones básicas óptimas:\n\n");
         
         double *sol1 = g_new0(double, info->num_vars);
         double *sol2 = g_new0(double, info->num_vars);
@@ -979,8 +1158,8 @@ void generar_solucion_multiple_latex(GString *latex, ResultadoSimplex *resultado
         for (int k = 0; k < 3; k++) {
             double lambda = (k + 1) * 0.25; 
             
-            g_string_append_printf(latex, "\\subsubsection{Solución con $\\lambda = %.2f$}\n", lambda);
-            g_string_append(latex, "\\begin{align*}\n");
+            salida_printf(latex, "\\subsubsection{Solución con $\\lambda = %.2f$}\n", lambda);
+            salida_append(latex, "\\begin{align*}\n");
             
             for (int i = 0; i < info->num_vars; i++) {
                 double valor_solucion = lambda * sol1[i] + (1.0 - lambda) * sol2[i];
@@ -989,12 +1168,12 @@ void generar_solucion_multiple_latex(GString *latex, ResultadoSimplex *resultado
                 char var_latex[64];
                 formatear_nombre_variable_latex(info->nombres_vars[i], var_latex, sizeof(var_latex));
                 
-                g_string_append_printf(latex, "%s &= %s", var_latex, sol_buffer);
+                salida_printf(latex, "%s &= %s", var_latex, sol_buffer);
                 if (i < info->num_vars - 1) {
-                    g_string_append(latex, " \\\\\n");
+                    salida_append(latex, " \\\\\n");
                 }
             }
-            g_string_append(latex, "\n\\end{align*}\n\n");
+            salida_append(latex, "\n\\end{align*}\n\n");
             
             double z_calculado = 0.0;
             for (int i = 0; i < info->num_vars; i++) {
@@ -1004,7 +1183,7 @@ void generar_solucion_multiple_latex(GString *latex, ResultadoSimplex *resultado
             
             char z_buffer[32];
             formatear_numero(z_calculado, z_buffer, sizeof(z_buffer));
-            g_string_append_printf(latex, "\\textbf{Valor de Z:} $%s$ (mismo valor óptimo)\\\\\n\n", z_buffer);
+            salida_printf(latex, "\\textbf{Valor de Z:} $%s$ (mismo valor óptimo)\\\\\n\n", z_buffer);
         }
         
         g_free(sol1);
@@ -1013,28 +1192,28 @@ void generar_solucion_multiple_latex(GString *latex, ResultadoSimplex *resultado
 }
 
 // Función para generar explicación de problemas especiales
-static void generar_explicacion_problemas_especiales_latex(GString *latex, ResultadoSimplex *resultado) {
+static void generar_explicacion_problemas_especiales_latex(Salida *latex, ResultadoSimplex *resultado) {
     switch (resultado->tipo_solucion) {
         case SOLUCION_NO_ACOTADA:
-            g_string_append(latex, "\\subsection{Explicación del Problema No Acotado}\n\n");
-            g_string_append(latex, "Un problema de programación lineal se considera \\textbf{no acotado} cuando la función objetivo puede mejorar indefinidamente sin violar ninguna restricción.\n\n");
-            g_string_append(latex, "\\textbf{Condiciones para no acotamiento:}\n");
-            g_string_append(latex, "\\begin{itemize}\n");
-            g_string_append(latex, "\\item Existe al menos una variable que puede aumentar indefinidamente\n");
-            g_string_append(latex, "\\item Todos los coeficientes en la columna pivote son negativos o cero\n");
-            g_string_append(latex, "\\item No hay restricciones que limiten el crecimiento de la variable\n");
-            g_string_append(latex, "\\end{itemize}\n\n");
+            salida_append(latex, "\\subsection{Explicación del Problema No Acotado}\n\n");
+            salida_append(latex, "Un problema de programación lineal se considera \\textbf{no acotado} cuando la función objetivo puede mejorar indefinidamente sin violar ninguna restricción.\n\n");
+            salida_append(latex, "\\textbf{Condiciones para no acotamiento:}\n");
+            salida_append(latex, "\\begin{itemize}\n");
+            salida_append(latex, "\\item Existe al menos una variable que puede aumentar indefinidamente\n");
+            salida_append(latex, "\\item Todos los coeficientes en la columna pivote son negativos o cero\n");
+            salida_append(latex, "\\item No hay restricciones que limiten el crecimiento de la variable\n");
+            salida_append(latex, "\\end{itemize}\n\n");
             break;
             
         case SOLUCION_NO_FACTIBLE:
-            g_string_append(latex, "\\subsection{Explicación del Problema No Factible}\n\n");
-            g_string_append(latex, "Un problema de programación lineal se considera \\textbf{no factible} cuando no existe ninguna solución que satisfaga todas las restricciones simultáneamente.\n\n");
-            g_string_append(latex, "\\textbf{Causas comunes:}\n");
-            g_string_append(latex, "\\begin{itemize}\n");
-            g_string_append(latex, "\\item Restricciones contradictorias\n");
-            g_string_append(latex, "\\item Región factible vacía\n");
-            g_string_append(latex, "\\item Variables artificiales permanecen en la base con valor positivo\n");
-            g_string_append(latex, "\\end{itemize}\n\n");
+            salida_append(latex, "\\subsection{Explicación del Problema No Factible}\n\n");
+            salida_append(latex, "Un problema de programación lineal se considera \\textbf{no factible} cuando no existe ninguna solución que satisfaga todas las restricciones simultáneamente.\n\n");
+            salida_append(latex, "\\textbf{Causas comunes:}\n");
+            salida_append(latex, "\\begin{itemize}\n");
+            salida_append(latex, "\\item Restricciones contradictorias\n");
+            salida_append(latex, "\\item Región factible vacía\n");
+            salida_append(latex, "\\item Variables artificiales permanecen en la base con valor positivo\n");
+            salida_append(latex, "\\end{itemize}\n\n");
             break;
             
         default:
@@ -1043,80 +1222,85 @@ static void generar_explicacion_problemas_especiales_latex(GString *latex, Resul
 }
 
 // Función para generar conclusión
-void generar_conclusion_latex(GString *latex, ResultadoSimplex *resultado, ProblemaInfo *info) {
-    g_string_append(latex, "\\section{Conclusión}\n\n");
+void generar_conclusion_latex(Salida *latex, ResultadoSimplex *resultado, ProblemaInfo *info) {
+    salida_append(latex, "\\section{Conclusión}\n\n");
     
     switch (resultado->tipo_solucion) {
         case SOLUCION_OPTIMA:
-            g_string_append(latex, "El problema tiene una \\textbf{solución óptima única}.\\\\\n");
-            g_string_append_printf(latex, "El valor óptimo de la función objetivo es: \\textbf{Z = %.2f}\\\\\n", 
+            salida_append(latex, "El problema tiene una \\textbf{solución óptima única}.\\\\\n");
+            salida_printf(latex, "El valor óptimo de la función objetivo es: \\textbf{Z = %.2f}\\\\\n", 
                                   resultado->valor_z);
             break;
             
         case SOLUCION_MULTIPLE:
-            g_string_append(latex, "El problema tiene \\textbf{múltiples soluciones óptimas}.\\\\\n");
-            g_string_append_printf(latex, "El valor óptimo de la función objetivo es: \\textbf{Z = %.2f}\\\\\n", 
+            salida_append(latex, "El problema tiene \\textbf{múltiples soluciones óptimas}.\\\\\n");
+            salida_printf(latex, "El valor óptimo de la función objetivo es: \\textbf{Z = %.2f}\\\\\n", 
                                   resultado->valor_z);
-            g_string_append(latex, "Existen infinitos puntos que alcanzan este valor óptimo.\\\\\n");
+            salida_append(latex, "Existen infinitos puntos que alcanzan este valor óptimo.\\\\\n");
             break;
             
         case SOLUCION_NO_ACOTADA:
-            g_string_append(latex, "El problema es \\textbf{no acotado}.\\\\\n");
-            g_string_append(latex, "La función objetivo puede mejorar indefinidamente sin violar las restricciones.\\\\\n");
+            salida_append(latex, "El problema es \\textbf{no acotado}.\\\\\n");
+            salida_append(latex, "La función objetivo puede mejorar indefinidamente sin violar las restricciones.\\\\\n");
             break;
             
         case SOLUCION_NO_FACTIBLE:
-            g_string_append(latex, "El problema es \\textbf{no factible}.\\\\\n");
-            g_string_append(latex, "No existe ninguna solución que satisfaga todas las restricciones simultáneamente.\\\\\n");
+            salida_append(latex, "El problema es \\textbf{no factible}.\\\\\n");
+            salida_append(latex, "No existe ninguna solución que satisfaga todas las restricciones simultáneamente.\\\\\n");
+            break;
+            
+        case SOLUCION_INTERRUMPIDA:
+            salida_append(latex, "La resolución fue \\textbf{interrumpida} antes de terminar.\\\\\n");
+            salida_printf(latex, "Se completaron %d iteraciones; el valor de Z en la última tabla es %.2f.\\\\\n", 
+                                  resultado->iteraciones, resultado->valor_z);
             break;
     }
     
     if (resultado->mensaje) {
         char *mensaje_escape = escape_latex(resultado->mensaje);
-        g_string_append_printf(latex, "\\textbf{Mensaje:} %s\\\\\n", mensaje_escape);
+        salida_printf(latex, "\\textbf{Mensaje:} %s\\\\\n", mensaje_escape);
         g_free(mensaje_escape);
     }
     
-    g_string_append(latex, "\n\\textbf{Recomendaciones:}\n");
-    g_string_append(latex, "\\begin{itemize}\n");
+    salida_append(latex, "\n\\textbf{Recomendaciones:}\n");
+    salida_append(latex, "\\begin{itemize}\n");
     
     switch (resultado->tipo_solucion) {
         case SOLUCION_OPTIMA:
-            g_string_append(latex, "\\item La solución encontrada es óptima y puede implementarse directamente.\n");
+            salida_append(latex, "\\item La solución encontrada es óptima y puede implementarse directamente.\n");
             if (resultado->es_degenerado) {
-                g_string_append(latex, "\\item Aunque el problema es degenerado, la solución sigue siendo válida.\n");
+                salida_append(latex, "\\item Aunque el problema es degenerado, la solución sigue siendo válida.\n");
             }
             break;
         case SOLUCION_MULTIPLE:
-            g_string_append(latex, "\\item Se pueden elegir diferentes soluciones según criterios adicionales.\n");
-            g_string_append(latex, "\\item Considere factores externos para seleccionar la solución más apropiada.\n");
+            salida_append(latex, "\\item Se pueden elegir diferentes soluciones según criterios adicionales.\n");
+            salida_append(latex, "\\item Considere factores externos para seleccionar la solución más apropiada.\n");
             break;
         case SOLUCION_NO_ACOTADA:
-            g_string_append(latex, "\\item Revise la formulación del problema.\n");
-            g_string_append(latex, "\\item Posiblemente falten restricciones importantes.\n");
+            salida_append(latex, "\\item Revise la formulación del problema.\n");
+            salida_append(latex, "\\item Posiblemente falten restricciones importantes.\n");
             break;
         case SOLUCION_NO_FACTIBLE:
-            g_string_append(latex, "\\item Revise las restricciones del problema.\n");
-            g_string_append(latex, "\\item Puede haber conflictos entre las restricciones.\n");
+            salida_append(latex, "\\item Revise las restricciones del problema.\n");
+            salida_append(latex, "\\item Puede haber conflictos entre las restricciones.\n");
+            break;
+        case SOLUCION_INTERRUMPIDA:
+            salida_append(latex, "\\item Vuelva a resolver sin límite de tiempo para obtener la solución final.\n");
             break;
     }
     
-    g_string_append(latex, "\\end{itemize}\n\n");
+    salida_append(latex, "\\end{itemize}\n\n");
 }
 
 // Función principal para generar el documento LaTeX completo
-void generar_documento_latex(ResultadoSimplex *resultado, ProblemaInfo *info, const char *nombre_archivo, gboolean mostrar_tablas) {
-    FILE *archivo = fopen(nombre_archivo, "w");
-    if (!archivo) {
-        g_printerr("Error: No se pudo abrir el archivo %s para escritura\n", nombre_archivo);
-        return;
-    }
-    
-    GString *latex = g_string_new("");
+// Escribe el documento completo en la salida indicada (no la cierra).
+// Con opciones = NULL el reporte es completo, sin límites de tamaño.
+void generar_documento_latex_salida(Salida *latex, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                    gboolean mostrar_tablas, const OpcionesReporte *opciones) {
     generar_portada_latex(latex, info->nombre_problema);
     generar_algoritmo_simplex_latex(latex);
     generar_problema_original_latex(latex, info);
-    g_string_append(latex, "\\section{Método de Solución}\n\n");
+    salida_append(latex, "\\section{Método de Solución}\n\n");
     gboolean uso_gran_m = FALSE;
     if (resultado->tablas_intermedias && resultado->num_tablas > 0) {
         TablaSimplex *primera_tabla = resultado->tablas_intermedias[0];
@@ -1126,58 +1310,58 @@ void generar_documento_latex(ResultadoSimplex *resultado, ProblemaInfo *info, co
     }
     
     if (uso_gran_m) {
-        g_string_append(latex, "Se utilizó el \\textbf{método de la Gran M} debido a la presencia ");
-        g_string_append(latex, "de restricciones de tipo $\\geq$ o $=$.\n\n");
+        salida_append(latex, "Se utilizó el \\textbf{método de la Gran M} debido a la presencia ");
+        salida_append(latex, "de restricciones de tipo $\\geq$ o $=$.\n\n");
         
-        g_string_append(latex, "\\begin{itemize}\n");
-        g_string_append_printf(latex, "\\item Valor de M utilizado: $\\mathbf{%.0f}$\n", M_GRANDE);
-        g_string_append(latex, "\\item Se introdujeron variables artificiales para las restricciones relevantes\n");
-        g_string_append(latex, "\\item El método garantiza encontrar una solución factible si existe\n");
-        g_string_append(latex, "\\end{itemize}\n\n");
+        salida_append(latex, "\\begin{itemize}\n");
+        salida_printf(latex, "\\item Valor de M utilizado: $\\mathbf{%.0f}$\n", M_GRANDE);
+        salida_append(latex, "\\item Se introdujeron variables artificiales para las restricciones relevantes\n");
+        salida_append(latex, "\\item El método garantiza encontrar una solución factible si existe\n");
+        salida_append(latex, "\\end{itemize}\n\n");
     } else {
-        g_string_append(latex, "Se utilizó el \\textbf{método simplex estándar}.\n\n");
+        salida_append(latex, "Se utilizó el \\textbf{método simplex estándar}.\n\n");
         
-        g_string_append(latex, "\\begin{itemize}\n");
-        g_string_append(latex, "\\item Todas las restricciones son del tipo $\\leq$\n");
-        g_string_append(latex, "\\item Se introdujeron variables de holgura\n");
-        g_string_append(latex, "\\item No fue necesario utilizar el método de la Gran M\n");
-        g_string_append(latex, "\\end{itemize}\n\n");
+        salida_append(latex, "\\begin{itemize}\n");
+        salida_append(latex, "\\item Todas las restricciones son del tipo $\\leq$\n");
+        salida_append(latex, "\\item Se introdujeron variables de holgura\n");
+        salida_append(latex, "\\item No fue necesario utilizar el método de la Gran M\n");
+        salida_append(latex, "\\end{itemize}\n\n");
     }
     
     if (resultado->tablas_intermedias && resultado->num_tablas > 0) {
-        generar_tabla_inicial_latex(latex, resultado->tablas_intermedias[0], info);
+        generar_tabla_inicial_latex(latex, resultado->tablas_intermedias[0], info, opciones);
     }
     
     if (mostrar_tablas && resultado->tablas_intermedias && resultado->num_tablas > 1) {
-        generar_tablas_intermedias_latex(latex, resultado->tablas_intermedias, resultado->num_tablas, info, resultado);
+        generar_tablas_intermedias_latex(latex, resultado->tablas_intermedias, resultado->num_tablas, info, resultado, opciones);
     }
     
     if (resultado->tablas_intermedias && resultado->num_tablas > 0) {
-        generar_tabla_final_latex(latex, resultado, info);
+        generar_tabla_final_latex(latex, resultado, info, opciones);
     }
     
-    g_string_append(latex, "\\section{Resultados}\n\n");
-    g_string_append(latex, "\\subsection{Solución Encontrada}\n\n"); 
+    salida_append(latex, "\\section{Resultados}\n\n");
+    salida_append(latex, "\\subsection{Solución Encontrada}\n\n"); 
     if (resultado->tipo_solucion == SOLUCION_OPTIMA || resultado->tipo_solucion == SOLUCION_MULTIPLE) {
-        g_string_append_printf(latex, "\\textbf{Valor óptimo de Z:} $\\mathbf{%.2f}$\\\\\n\n", resultado->valor_z);
+        salida_printf(latex, "\\textbf{Valor óptimo de Z:} $\\mathbf{%.2f}$\\\\\n\n", resultado->valor_z);
         TablaSimplex *tabla_final = resultado->tablas_intermedias[resultado->num_tablas - 1];
-        g_string_append(latex, "\\textbf{Valores de todas las variables:}\\\\\n");
-        g_string_append(latex, "\\begin{align*}\n");
+        salida_append(latex, "\\textbf{Valores de todas las variables:}\\\\\n");
+        salida_append(latex, "\\begin{align*}\n");
         for (int i = 0; i < info->num_vars; i++) {
             char var_latex[64];
             formatear_nombre_variable_latex(info->nombres_vars[i], var_latex, sizeof(var_latex));
             char num_buffer[32];
             formatear_numero(resultado->solucion[i], num_buffer, sizeof(num_buffer));
-            g_string_append_printf(latex, "%s &= %s", var_latex, num_buffer);
+            salida_printf(latex, "%s &= %s", var_latex, num_buffer);
             if (i < info->num_vars - 1) {
-                g_string_append(latex, " \\\\\n");
+                salida_append(latex, " \\\\\n");
             }
         }
         
         // Mostrar variables de holgura
         for (int i = info->num_vars; i < info->num_vars + tabla_final->num_vars_holgura; i++) {
             char var_latex[64];
-            formatear_nombre_variable_latex(tabla_final->nombres_vars[i], var_latex, sizeof(var_latex));
+            formatear_nombre_variable_latex(obtener_nombre_variable(tabla_final, i), var_latex, sizeof(var_latex));
             double valor = 0.0;
             for (int j = 0; j < tabla_final->num_restricciones; j++) {
                 if (tabla_final->variables_base[j] == i) {
@@ -1188,13 +1372,13 @@ void generar_documento_latex(ResultadoSimplex *resultado, ProblemaInfo *info, co
             
             char num_buffer[32];
             formatear_numero(valor, num_buffer, sizeof(num_buffer));
-            g_string_append_printf(latex, " \\\\\n%s &= %s", var_latex, num_buffer);
+            salida_printf(latex, " \\\\\n%s &= %s", var_latex, num_buffer);
         }
         
         for (int i = info->num_vars + tabla_final->num_vars_holgura; 
             i < info->num_vars + tabla_final->num_vars_holgura + tabla_final->num_vars_exceso; i++) {
             char var_latex[64];
-            formatear_nombre_variable_latex(tabla_final->nombres_vars[i], var_latex, sizeof(var_latex));
+            formatear_nombre_variable_latex(obtener_nombre_variable(tabla_final, i), var_latex, sizeof(var_latex));
             double valor = 0.0;
             for (int j = 0; j < tabla_final->num_restricciones; j++) {
                 if (tabla_final->variables_base[j] == i) {
@@ -1205,13 +1389,13 @@ void generar_documento_latex(ResultadoSimplex *resultado, ProblemaInfo *info, co
             
             char num_buffer[32];
             formatear_numero(valor, num_buffer, sizeof(num_buffer));
-            g_string_append_printf(latex, " \\\\\n%s &= %s", var_latex, num_buffer);
+            salida_printf(latex, " \\\\\n%s &= %s", var_latex, num_buffer);
         }
         
         for (int i = info->num_vars + tabla_final->num_vars_holgura + tabla_final->num_vars_exceso;
             i < info->num_vars + tabla_final->num_vars_holgura + tabla_final->num_vars_exceso + tabla_final->num_vars_artificiales; i++) {
             char var_latex[64];
-            formatear_nombre_variable_latex(tabla_final->nombres_vars[i], var_latex, sizeof(var_latex));
+            formatear_nombre_variable_latex(obtener_nombre_variable(tabla_final, i), var_latex, sizeof(var_latex));
             double valor = 0.0;
             for (int j = 0; j < tabla_final->num_restricciones; j++) {
                 if (tabla_final->variables_base[j] == i) {
@@ -1222,10 +1406,10 @@ void generar_documento_latex(ResultadoSimplex *resultado, ProblemaInfo *info, co
             
             char num_buffer[32];
             formatear_numero(valor, num_buffer, sizeof(num_buffer));
-            g_string_append_printf(latex, " \\\\\n%s &= %s", var_latex, num_buffer);
+            salida_printf(latex, " \\\\\n%s &= %s", var_latex, num_buffer);
         }
         
-        g_string_append(latex, "\n\\end{align*}\n\n");
+        salida_append(latex, "\n\\end{align*}\n\n");
     }
     
     if (resultado->tipo_solucion == SOLUCION_MULTIPLE) {
@@ -1234,58 +1418,23 @@ void generar_documento_latex(ResultadoSimplex *resultado, ProblemaInfo *info, co
     
     generar_explicacion_problemas_especiales_latex(latex, resultado);
     generar_conclusion_latex(latex, resultado, info);
-    g_string_append(latex, "\\end{document}\n");
-    fwrite(latex->str, 1, latex->len, archivo);
-    fclose(archivo);
-    
-    g_string_free(latex, TRUE);
-    
-    g_print("Archivo LaTeX generado: %s\n", nombre_archivo);
+    salida_append(latex, "\\end{document}\n");
 }
 
-// Función para compilar y mostrar el PDF
-void compilar_y_mostrar_pdf(const char *nombre_archivo_tex, const char *nombre_archivo_pdf) {
-    char comando[2048];
-    system("mkdir -p ProblemasSimplex");
-
-    char comando_mover[512];
-    snprintf(comando_mover, sizeof(comando_mover),
-             "mv %s ProblemasSimplex/ 2>/dev/null", nombre_archivo_tex);
-    system(comando_mover);
-
-    snprintf(comando, sizeof(comando),
-             "cd ProblemasSimplex && pdflatex -interaction=nonstopmode %s > /dev/null 2>&1",
-             nombre_archivo_tex);
-
-    int result1 = system(comando);
-    int result2 = system(comando);
-
-    if (result1 != 0 || result2 != 0) {
-        g_printerr("Advertencia: Puede haber errores en la compilación LaTeX\n");
+gboolean generar_documento_latex(ResultadoSimplex *resultado, ProblemaInfo *info, const char *nombre_archivo,
+                                 gboolean mostrar_tablas, const OpcionesReporte *opciones) {
+    Salida *latex = salida_archivo(nombre_archivo);
+    if (!latex) {
+        g_printerr("Error: No se pudo abrir el archivo %s para escritura\n", nombre_archivo);
+        return FALSE;
     }
-
-    char nombre_base[256];
-    size_t len = strlen(nombre_archivo_tex);
-
-    if (len > 4) {
-        size_t base_len = len - 4;
-        if (base_len >= sizeof(nombre_base))
-            base_len = sizeof(nombre_base) - 1;
-
-        strncpy(nombre_base, nombre_archivo_tex, base_len);
-        nombre_base[base_len] = '\0';
-
-        snprintf(comando, sizeof(comando),
-                 "cd ProblemasSimplex && rm -f %s.{aux,log,out,toc}",
-                 nombre_base);
-
-        system(comando);
+    
+    generar_documento_latex_salida(latex, resultado, info, mostrar_tablas, opciones);
+    if (!salida_cerrar(latex)) {
+        g_printerr("Error: No se pudo escribir completo el archivo %s\n", nombre_archivo);
+        return FALSE;
     }
-
-    snprintf(comando, sizeof(comando),
-             "cd ProblemasSimplex && if [ -f %s ]; then evince --presentation %s > /dev/null 2>&1 & fi",
-             nombre_archivo_pdf, nombre_archivo_pdf);
-    system(comando);
-
-    g_print("PDF generado y abierto: ProblemasSimplex/%s\n", nombre_archivo_pdf);
-}
\ No newline at end of file
+    
+    g_print("Archivo LaTeX generado: %s\n", nombre_archivo);
+    return TRUE;
+}
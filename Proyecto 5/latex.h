@@ -3,29 +3,51 @@
 
 #include <glib.h>
 #include "simplex.h"
+#include "salida.h"
+
+G_BEGIN_DECLS
 
 // Estructura para información de pivote
 typedef struct {
     int fila_pivote;
     int columna_pivote;
     double valor_pivote;
-    char* variable_entra;
-    char* variable_sale;
+    const char* variable_entra;   // Apuntan a la tabla de nombres compartida
+    const char* variable_sale;
     double* razones;
     gboolean hay_empate;
     int* filas_empate;
     int num_empates;
 } InfoPivote;
 
+// Límites del reporte para problemas grandes; un campo en 0 significa "sin límite".
+// Con ambos límites el tamaño queda acotado: 2K tablas completas de a lo sumo
+// (restricciones + 2) columnas y una línea por cada iteración restante.
+typedef struct {
+    int iteraciones_completas;   // K: primeras y últimas K iteraciones con su tabla completa (0 = todas)
+    int max_columnas;            // Con más variables, las tablas muestran solo las básicas y la que entra (0 = todas)
+} OpcionesReporte;
+
+#define REPORTE_ITERACIONES_COMPLETAS 3
+#define REPORTE_MAX_COLUMNAS 12
+
 // Declaraciones de funciones
-void generar_documento_latex(ResultadoSimplex *resultado, ProblemaInfo *info, const char *nombre_archivo, gboolean mostrar_tablas);
-void generar_problema_original_latex(GString *latex, ProblemaInfo *info);
-void generar_tabla_latex(GString *latex, TablaSimplex *tabla, const char *titulo, int iteracion, gboolean es_final, InfoPivote *info_pivote);
-void generar_tabla_inicial_latex(GString *latex, TablaSimplex *tabla, ProblemaInfo *info);
-void generar_tablas_intermedias_latex(GString *latex, TablaSimplex **tablas, int num_tablas, ProblemaInfo *info, ResultadoSimplex *resultado);
-void generar_tabla_final_latex(GString *latex, ResultadoSimplex *resultado, ProblemaInfo *info);
-void generar_solucion_multiple_latex(GString *latex, ResultadoSimplex *resultado, ProblemaInfo *info);
-void generar_conclusion_latex(GString *latex, ResultadoSimplex *resultado, ProblemaInfo *info);
-void compilar_y_mostrar_pdf(const char *nombre_archivo_tex, const char *nombre_archivo_pdf);
+gboolean generar_documento_latex(ResultadoSimplex *resultado, ProblemaInfo *info, const char *nombre_archivo,
+                                 gboolean mostrar_tablas, const OpcionesReporte *opciones);
+void generar_documento_latex_salida(Salida *latex, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                    gboolean mostrar_tablas, const OpcionesReporte *opciones);
+void generar_problema_original_latex(Salida *latex, ProblemaInfo *info);
+void generar_tabla_latex(Salida *latex, TablaSimplex *tabla, const char *titulo, int iteracion, gboolean es_final, InfoPivote *info_pivote);
+void generar_tabla_inicial_latex(Salida *latex, TablaSimplex *tabla, ProblemaInfo *info, const OpcionesReporte *opciones);
+void generar_tablas_intermedias_latex(Salida *latex, TablaSimplex **tablas, int num_tablas, ProblemaInfo *info, ResultadoSimplex *resultado, const OpcionesReporte *opciones);
+void generar_tabla_final_latex(Salida *latex, ResultadoSimplex *resultado, ProblemaInfo *info, const OpcionesReporte *opciones);
+void generar_solucion_multiple_latex(Salida *latex, ResultadoSimplex *resultado, ProblemaInfo *info);
+void generar_conclusion_latex(Salida *latex, ResultadoSimplex *resultado, ProblemaInfo *info);
+const char* preambulo_latex(void);
+InfoPivote* calcular_info_pivote(TablaSimplex *tabla_actual, TablaSimplex *tabla_siguiente);
+void liberar_info_pivote(InfoPivote *info);
+int* ventana_columnas_reporte(TablaSimplex *tabla, const OpcionesReporte *opciones, int columna_entra, int *num_columnas);
+
+G_END_DECLS
 
 #endif
\ No newline at end of file
@@ -0,0 +1,612 @@
+#include "lp.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+
+#define LP_TAM_BUFER (64 * 1024)
+
+typedef enum {
+    TOKEN_FIN,
+    TOKEN_NUMERO,
+    TOKEN_NOMBRE,
+    TOKEN_ETIQUETA,     // Nombre seguido de ':'
+    TOKEN_MAS,
+    TOKEN_MENOS,
+    TOKEN_OPERADOR      // <=, >= o =
+} TipoToken;
+
+typedef enum {
+    SECCION_LP_NINGUNA,
+    SECCION_LP_OBJETIVO,
+    SECCION_LP_RESTRICCIONES,
+    SECCION_LP_COTAS,
+    SECCION_LP_GENERALES,
+    SECCION_LP_BINARIAS,
+    SECCION_LP_FIN
+} SeccionLp;
+
+typedef struct {
+    TipoToken tipo;
+    double valor;
+    TipoRestriccion operador;
+    gboolean inicio_linea;      // Primer token de su línea (las secciones solo empiezan ahí)
+    int linea;
+} TokenLp;
+
+typedef struct {
+    int fila;
+    int columna;
+    double valor;
+} CoeficienteLp;
+
+typedef struct {
+    const char *ruta;
+    FILE *archivo;
+    char bufer[LP_TAM_BUFER];
+    gsize pos;
+    gsize largo;
+    int linea;
+    gboolean nueva_linea;       // No hubo tokens desde el último salto de línea
+    gboolean error;
+
+    TokenLp actual;
+    GString *texto;             // Texto del token actual (nombres)
+
+    gchar *nombre;
+    TipoProblema tipo;
+    GStringChunk *nombres;      // Cada nombre de variable se guarda una sola vez
+    GHashTable *indice_columnas;    // Nombre internado -> índice + 1
+    GPtrArray *nombres_columnas;
+    GArray *c;                  // double por columna
+    GArray *cotas;              // CotaVariable por columna
+    GArray *coeficientes;       // CoeficienteLp de las restricciones
+    GArray *tipos_filas;        // TipoRestriccion por fila
+    GArray *lados_derechos;     // double por fila
+} LectorLp;
+
+static void error_lp(LectorLp *lector, const char *formato, ...) G_GNUC_PRINTF(2, 3);
+
+static void error_lp(LectorLp *lector, const char *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    gchar *mensaje = g_strdup_vprintf(formato, args);
+    va_end(args);
+
+    if (!lector->error) {
+        g_printerr("%s:%d: %s\n", lector->ruta, lector->actual.linea, mensaje);
+    }
+    lector->error = TRUE;
+    g_free(mensaje);
+}
+
+// ---------------- Lectura del archivo ----------------
+
+// Carácter en la posición 'k' a partir de la actual (EOF al final del archivo).
+// El búfer se recarga por bloques, así que el archivo nunca está entero en memoria.
+static int ver(LectorLp *lector, gsize k) {
+    if (lector->pos + k >= lector->largo) {
+        gsize resto = lector->largo - lector->pos;
+        memmove(lector->bufer, lector->bufer + lector->pos, resto);
+        lector->pos = 0;
+        lector->largo = resto + fread(lector->bufer + resto, 1, LP_TAM_BUFER - resto, lector->archivo);
+        if (k >= lector->largo) return EOF;
+    }
+    return (unsigned char)lector->bufer[lector->pos + k];
+}
+
+static void avanzar_caracter(LectorLp *lector) {
+    if (lector->bufer[lector->pos] == '\n') lector->linea++;
+    lector->pos++;
+}
+
+// Caracteres válidos en un nombre, según el formato LP
+static gboolean es_caracter_nombre(int c) {
+    return c != EOF && (g_ascii_isalnum(c) || strchr("!\"#$%&()/,.;?@_`'{}|~", c) != NULL);
+}
+
+// "\Problem name: ..." es el comentario con que CPLEX guarda el nombre del problema
+static void leer_comentario(LectorLp *lector) {
+    GString *comentario = g_string_new(NULL);
+    int c;
+    while ((c = ver(lector, 0)) != EOF && c != '\n') {
+        g_string_append_c(comentario, (char)c);
+        avanzar_caracter(lector);
+    }
+    const char *prefijo = "\\Problem name:";
+    if (!lector->nombre && g_ascii_strncasecmp(comentario->str, prefijo, strlen(prefijo)) == 0) {
+        lector->nombre = g_strstrip(g_strdup(comentario->str + strlen(prefijo)));
+    }
+    g_string_free(comentario, TRUE);
+}
+
+static void leer_numero(LectorLp *lector, TokenLp *token) {
+    char numero[64];
+    gsize largo = 0;
+    int c;
+
+    while ((c = ver(lector, 0)) != EOF && (g_ascii_isdigit(c) || c == '.') && largo + 1 < sizeof(numero)) {
+        numero[largo++] = (char)c;
+        avanzar_caracter(lector);
+    }
+    // El exponente solo se toma si sigue un dígito, para que "2e" no se coma la variable e
+    if ((c == 'e' || c == 'E') && largo + 4 < sizeof(numero)) {
+        int s = ver(lector, 1);
+        gboolean con_signo = (s == '+' || s == '-');
+        if (g_ascii_isdigit(con_signo ? ver(lector, 2) : s)) {
+            numero[largo++] = (char)c;
+            avanzar_caracter(lector);
+            if (con_signo) {
+                numero[largo++] = (char)s;
+                avanzar_caracter(lector);
+            }
+            while ((c = ver(lector, 0)) != EOF && g_ascii_isdigit(c) && largo + 1 < sizeof(numero)) {
+                numero[largo++] = (char)c;
+                avanzar_caracter(lector);
+            }
+        }
+    }
+    numero[largo] = '\0';
+
+    char *fin;
+    token->tipo = TOKEN_NUMERO;
+    token->valor = g_ascii_strtod(numero, &fin);
+    if (fin == numero || *fin != '\0') {
+        error_lp(lector, "número no válido: '%s'", numero);
+    }
+}
+
+static void siguiente_token(LectorLp *lector) {
+    TokenLp *token = &lector->actual;
+    int c;
+
+    // Espacios y comentarios
+    while ((c = ver(lector, 0)) != EOF) {
+        if (c == '\\') {
+            leer_comentario(lector);
+        } else if (g_ascii_isspace(c)) {
+            if (c == '\n') lector->nueva_linea = TRUE;
+            avanzar_caracter(lector);
+        } else {
+            break;
+        }
+    }
+
+    token->inicio_linea = lector->nueva_linea;
+    lector->nueva_linea = FALSE;
+    token->linea = lector->linea;
+    if (c == EOF) {
+        token->tipo = TOKEN_FIN;
+        return;
+    }
+
+    if (g_ascii_isdigit(c) || c == '.') {
+        leer_numero(lector, token);
+        return;
+    }
+
+    if (es_caracter_nombre(c)) {
+        g_string_truncate(lector->texto, 0);
+        while (es_caracter_nombre(c = ver(lector, 0))) {
+            g_string_append_c(lector->texto, (char)c);
+            avanzar_caracter(lector);
+        }
+        while ((c = ver(lector, 0)) == ' ' || c == '\t') {
+            avanzar_caracter(lector);
+        }
+        token->tipo = TOKEN_NOMBRE;
+        if (c == ':') {
+            avanzar_caracter(lector);
+            token->tipo = TOKEN_ETIQUETA;
+        }
+        return;
+    }
+
+    avanzar_caracter(lector);
+    switch (c) {
+        case '+':
+            token->tipo = TOKEN_MAS;
+            return;
+        case '-':
+            token->tipo = TOKEN_MENOS;
+            return;
+        case '<':
+        case '>':
+        case '=': {
+            // <, <=, =<, >, >=, => y =
+            int siguiente = ver(lector, 0);
+            token->tipo = TOKEN_OPERADOR;
+            if (c == '=' && (siguiente == '<' || siguiente == '>')) {
+                c = siguiente;
+                avanzar_caracter(lector);
+            } else if (c != '=' && siguiente == '=') {
+                avanzar_caracter(lector);
+            }
+            token->operador = c == '<' ? RESTRICCION_LE : c == '>' ? RESTRICCION_GE : RESTRICCION_EQ;
+            return;
+        }
+        case '[':
+            error_lp(lector, "los términos cuadráticos no están soportados");
+            break;
+        default:
+            error_lp(lector, "carácter inesperado: '%c'", c);
+            break;
+    }
+    token->tipo = TOKEN_FIN;
+}
+
+// ---------------- Nombres y secciones ----------------
+
+static gboolean texto_es(LectorLp *lector, const char *const *palabras) {
+    for (int i = 0; palabras[i]; i++) {
+        if (g_ascii_strcasecmp(lector->texto->str, palabras[i]) == 0) return TRUE;
+    }
+    return FALSE;
+}
+
+static const char *const PALABRAS_MAX[] = { "max", "maximize", "maximise", "maximum", NULL };
+static const char *const PALABRAS_MIN[] = { "min", "minimize", "minimise", "minimum", NULL };
+static const char *const PALABRAS_ST[] = { "st", "s.t.", "st.", NULL };
+static const char *const PALABRAS_COTAS[] = { "bounds", "bound", NULL };
+static const char *const PALABRAS_GENERALES[] = { "general", "generals", "gen", NULL };
+static const char *const PALABRAS_BINARIAS[] = { "binary", "binaries", "bin", NULL };
+static const char *const PALABRAS_NO_SOPORTADAS[] = { "semi-continuous", "semis", "semi", "sos", NULL };
+static const char *const PALABRAS_INFINITO[] = { "inf", "infinity", NULL };
+
+static gboolean es_palabra_clave(LectorLp *lector) {
+    static const char *const *todas[] = {
+        PALABRAS_MAX, PALABRAS_MIN, PALABRAS_ST, PALABRAS_COTAS, PALABRAS_GENERALES,
+        PALABRAS_BINARIAS, PALABRAS_NO_SOPORTADAS, NULL
+    };
+    static const char *const otras[] = { "subject", "such", "end", NULL };
+
+    if (lector->actual.tipo != TOKEN_NOMBRE || !lector->actual.inicio_linea) return FALSE;
+    for (int i = 0; todas[i]; i++) {
+        if (texto_es(lector, todas[i])) return TRUE;
+    }
+    return texto_es(lector, otras);
+}
+
+// Si el token actual abre una sección, la consume y la devuelve
+static SeccionLp leer_seccion(LectorLp *lector) {
+    if (!es_palabra_clave(lector)) return SECCION_LP_NINGUNA;
+
+    SeccionLp seccion = SECCION_LP_NINGUNA;
+    if (texto_es(lector, PALABRAS_MAX) || texto_es(lector, PALABRAS_MIN)) {
+        lector->tipo = texto_es(lector, PALABRAS_MAX) ? MAXIMIZACION : MINIMIZACION;
+        seccion = SECCION_LP_OBJETIVO;
+    } else if (texto_es(lector, PALABRAS_ST)) {
+        seccion = SECCION_LP_RESTRICCIONES;
+    } else if (g_ascii_strcasecmp(lector->texto->str, "subject") == 0 ||
+               g_ascii_strcasecmp(lector->texto->str, "such") == 0) {
+        const char *segunda = g_ascii_strcasecmp(lector->texto->str, "subject") == 0 ? "to" : "that";
+        siguiente_token(lector);
+        if (lector->actual.tipo != TOKEN_NOMBRE || g_ascii_strcasecmp(lector->texto->str, segunda) != 0) {
+            error_lp(lector, "se esperaba '%s'", segunda);
+            return SECCION_LP_FIN;
+        }
+        seccion = SECCION_LP_RESTRICCIONES;
+    } else if (texto_es(lector, PALABRAS_COTAS)) {
+        seccion = SECCION_LP_COTAS;
+    } else if (texto_es(lector, PALABRAS_GENERALES)) {
+        seccion = SECCION_LP_GENERALES;
+    } else if (texto_es(lector, PALABRAS_BINARIAS)) {
+        seccion = SECCION_LP_BINARIAS;
+    } else if (texto_es(lector, PALABRAS_NO_SOPORTADAS)) {
+        error_lp(lector, "sección no soportada: %s", lector->texto->str);
+        return SECCION_LP_FIN;
+    } else {
+        seccion = SECCION_LP_FIN;
+    }
+    siguiente_token(lector);
+    return seccion;
+}
+
+// Índice de la variable del token actual; la crea la primera vez que aparece
+static int columna_actual(LectorLp *lector) {
+    const char *nombre = g_string_chunk_insert_const(lector->nombres, lector->texto->str);
+    int columna = GPOINTER_TO_INT(g_hash_table_lookup(lector->indice_columnas, nombre)) - 1;
+    if (columna < 0) {
+        CotaVariable cota = { 0.0, INFINITY };
+        double cero = 0.0;
+        columna = (int)lector->nombres_columnas->len;
+        g_ptr_array_add(lector->nombres_columnas, (gpointer)nombre);
+        g_array_append_val(lector->c, cero);
+        g_array_append_val(lector->cotas, cota);
+        g_hash_table_insert(lector->indice_columnas, (gpointer)nombre, GINT_TO_POINTER(columna + 1));
+    }
+    return columna;
+}
+
+// ---------------- Secciones ----------------
+
+static gboolean fin_de_expresion(LectorLp *lector) {
+    TipoToken tipo = lector->actual.tipo;
+    return lector->error || tipo == TOKEN_FIN || tipo == TOKEN_OPERADOR || tipo == TOKEN_ETIQUETA ||
+           es_palabra_clave(lector);
+}
+
+// Lee 'a x + b y - c ...' hasta un operador, una etiqueta o una sección. Los términos
+// van a la fila 'fila' (-1 es el objetivo) y las constantes se suman en 'constante'.
+// El modelo no tiene término independiente en Z, así que en el objetivo una constante
+// distinta de cero es un error y 'constante' puede ser NULL.
+static void leer_expresion(LectorLp *lector, int fila, double *constante) {
+    while (!fin_de_expresion(lector)) {
+        double signo = 1.0;
+        while (lector->actual.tipo == TOKEN_MAS || lector->actual.tipo == TOKEN_MENOS) {
+            if (lector->actual.tipo == TOKEN_MENOS) signo = -signo;
+            siguiente_token(lector);
+        }
+
+        int linea = lector->actual.linea;
+        double coeficiente = 1.0;
+        gboolean con_coeficiente = FALSE;
+        if (lector->actual.tipo == TOKEN_NUMERO) {
+            coeficiente = lector->actual.valor;
+            con_coeficiente = TRUE;
+            siguiente_token(lector);
+        }
+
+        if (lector->actual.tipo == TOKEN_NOMBRE && !es_palabra_clave(lector)) {
+            int columna = columna_actual(lector);
+            if (fila < 0) {
+                g_array_index(lector->c, double, columna) += signo * coeficiente;
+            } else {
+                CoeficienteLp coef = { fila, columna, signo * coeficiente };
+                g_array_append_val(lector->coeficientes, coef);
+            }
+            siguiente_token(lector);
+        } else if (con_coeficiente && fila < 0) {
+            if (coeficiente != 0.0) {
+                lector->actual.linea = linea;   // El error corresponde a la línea de la constante
+                error_lp(lector, "el objetivo no puede tener un término constante (%g)", signo * coeficiente);
+            }
+        } else if (con_coeficiente) {
+            *constante += signo * coeficiente;
+        } else {
+            error_lp(lector, "se esperaba un término");
+        }
+    }
+}
+
+// Número con signo opcional; acepta inf e infinity
+static gboolean leer_valor(LectorLp *lector, double *valor) {
+    double signo = 1.0;
+    while (lector->actual.tipo == TOKEN_MAS || lector->actual.tipo == TOKEN_MENOS) {
+        if (lector->actual.tipo == TOKEN_MENOS) signo = -signo;
+        siguiente_token(lector);
+    }
+
+    if (lector->actual.tipo == TOKEN_NUMERO) {
+        *valor = signo * lector->actual.valor;
+    } else if (lector->actual.tipo == TOKEN_NOMBRE && texto_es(lector, PALABRAS_INFINITO)) {
+        *valor = signo * INFINITY;
+    } else {
+        error_lp(lector, "se esperaba un número");
+        return FALSE;
+    }
+    siguiente_token(lector);
+    return TRUE;
+}
+
+static void leer_objetivo(LectorLp *lector) {
+    if (lector->actual.tipo == TOKEN_ETIQUETA) siguiente_token(lector);
+    leer_expresion(lector, -1, NULL);
+    if (!lector->error && lector->actual.tipo == TOKEN_OPERADOR) {
+        error_lp(lector, "el objetivo no puede tener un operador");
+    }
+}
+
+static void leer_restriccion(LectorLp *lector) {
+    int fila = (int)lector->tipos_filas->len;
+    double constante = 0.0;
+
+    if (lector->actual.tipo == TOKEN_ETIQUETA) siguiente_token(lector);
+    leer_expresion(lector, fila, &constante);
+    if (lector->error) return;
+    if (lector->actual.tipo != TOKEN_OPERADOR) {
+        error_lp(lector, "se esperaba <=, >= o =");
+        return;
+    }
+    TipoRestriccion tipo = lector->actual.operador;
+    siguiente_token(lector);
+
+    double lado_derecho;
+    if (!leer_valor(lector, &lado_derecho)) return;
+    if (!isfinite(lado_derecho)) {
+        error_lp(lector, "el lado derecho debe ser finito");
+        return;
+    }
+
+    lado_derecho -= constante;
+    g_array_append_val(lector->tipos_filas, tipo);
+    g_array_append_val(lector->lados_derechos, lado_derecho);
+}
+
+// 'x op v' si la variable está a la izquierda, 'v op x' si está a la derecha
+static void aplicar_cota(CotaVariable *cota, TipoRestriccion operador, double valor, gboolean variable_izquierda) {
+    if (operador == RESTRICCION_EQ) {
+        cota->inferior = cota->superior = valor;
+    } else if ((operador == RESTRICCION_LE) == variable_izquierda) {
+        cota->superior = valor;
+    } else {
+        cota->inferior = valor;
+    }
+}
+
+// 'x free', 'x op v', 'v op x' o 'v op x op w'
+static void leer_cota(LectorLp *lector) {
+    if (lector->actual.tipo == TOKEN_NOMBRE && !texto_es(lector, PALABRAS_INFINITO)) {
+        int columna = columna_actual(lector);
+        CotaVariable *cota = &g_array_index(lector->cotas, CotaVariable, columna);
+        siguiente_token(lector);
+
+        if (lector->actual.tipo == TOKEN_NOMBRE && g_ascii_strcasecmp(lector->texto->str, "free") == 0) {
+            cota->inferior = -INFINITY;
+            cota->superior = INFINITY;
+            siguiente_token(lector);
+            return;
+        }
+        if (lector->actual.tipo != TOKEN_OPERADOR) {
+            error_lp(lector, "se esperaba <=, >=, = o free");
+            return;
+        }
+        TipoRestriccion operador = lector->actual.operador;
+        double valor;
+        siguiente_token(lector);
+        if (leer_valor(lector, &valor)) aplicar_cota(cota, operador, valor, TRUE);
+        return;
+    }
+
+    double valor;
+    if (!leer_valor(lector, &valor)) return;
+    if (lector->actual.tipo != TOKEN_OPERADOR) {
+        error_lp(lector, "se esperaba <=, >= o =");
+        return;
+    }
+    TipoRestriccion operador = lector->actual.operador;
+    siguiente_token(lector);
+    if (lector->actual.tipo != TOKEN_NOMBRE) {
+        error_lp(lector, "se esperaba una variable");
+        return;
+    }
+    int columna = columna_actual(lector);
+    CotaVariable *cota = &g_array_index(lector->cotas, CotaVariable, columna);
+    aplicar_cota(cota, operador, valor, FALSE);
+    siguiente_token(lector);
+
+    if (lector->actual.tipo == TOKEN_OPERADOR) {
+        operador = lector->actual.operador;
+        siguiente_token(lector);
+        if (leer_valor(lector, &valor)) aplicar_cota(cota, operador, valor, TRUE);
+    }
+}
+
+static void leer_entera(LectorLp *lector, gboolean binaria) {
+    if (lector->actual.tipo != TOKEN_NOMBRE) {
+        error_lp(lector, "se esperaba una variable");
+        return;
+    }
+    int columna = columna_actual(lector);
+    if (binaria) {
+        CotaVariable *cota = &g_array_index(lector->cotas, CotaVariable, columna);
+        cota->inferior = 0.0;
+        cota->superior = 1.0;
+    }
+    siguiente_token(lector);
+}
+
+static void leer_archivo(LectorLp *lector) {
+    SeccionLp seccion = SECCION_LP_NINGUNA;
+    siguiente_token(lector);
+
+    while (!lector->error && lector->actual.tipo != TOKEN_FIN) {
+        SeccionLp nueva = leer_seccion(lector);
+        if (nueva == SECCION_LP_FIN) return;
+        if (nueva != SECCION_LP_NINGUNA) {
+            seccion = nueva;
+            continue;
+        }
+
+        switch (seccion) {
+            case SECCION_LP_OBJETIVO:
+                leer_objetivo(lector);
+                break;
+            case SECCION_LP_RESTRICCIONES:
+                leer_restriccion(lector);
+                break;
+            case SECCION_LP_COTAS:
+                leer_cota(lector);
+                break;
+            case SECCION_LP_GENERALES:
+            case SECCION_LP_BINARIAS:
+                leer_entera(lector, seccion == SECCION_LP_BINARIAS);
+                break;
+            default:
+                error_lp(lector, "se esperaba Maximize o Minimize");
+                break;
+        }
+    }
+}
+
+// ---------------- Construcción del modelo ----------------
+
+static Modelo* construir_modelo(LectorLp *lector) {
+    int n = (int)lector->nombres_columnas->len;
+    int m_filas = (int)lector->tipos_filas->len;
+    if (n == 0) {
+        g_printerr("%s: el modelo no tiene variables\n", lector->ruta);
+        return NULL;
+    }
+
+    const CotaVariable *cotas = (const CotaVariable*)lector->cotas->data;
+    int negativa = modelo_cota_negativa(cotas, n);
+    if (negativa >= 0) {
+        g_printerr("%s: la variable %s admite valores negativos; el método supone x >= 0\n",
+                   lector->ruta, (const char*)g_ptr_array_index(lector->nombres_columnas, negativa));
+        return NULL;
+    }
+
+    Modelo *modelo = modelo_nuevo(lector->nombre, lector->tipo, n, m_filas + modelo_filas_de_cotas(cotas, n));
+    for (int j = 0; j < n; j++) {
+        modelo_establecer_nombre_variable(modelo, j, g_ptr_array_index(lector->nombres_columnas, j));
+    }
+    memcpy(modelo->c, lector->c->data, n * sizeof(double));
+
+    for (guint k = 0; k < lector->coeficientes->len; k++) {
+        CoeficienteLp *coef = &g_array_index(lector->coeficientes, CoeficienteLp, k);
+        modelo->A[coef->fila][coef->columna] += coef->valor;
+    }
+    for (int r = 0; r < m_filas; r++) {
+        modelo->tipos_restricciones[r] = g_array_index(lector->tipos_filas, TipoRestriccion, r);
+        modelo->lados_derechos[r] = g_array_index(lector->lados_derechos, double, r);
+    }
+
+    modelo_agregar_cotas(modelo, m_filas, cotas);
+    modelo_normalizar_lados_derechos(modelo);
+    return modelo;
+}
+
+// Lee un archivo LP en una sola pasada, token por token. Devuelve NULL (y escribe el
+// motivo con g_printerr) si el archivo no existe, tiene errores o usa algo que el
+// método no puede representar.
+Modelo* modelo_cargar_lp(const char *ruta) {
+    FILE *archivo = fopen(ruta, "r");
+    if (!archivo) {
+        g_printerr("Error: No se pudo abrir el archivo %s\n", ruta);
+        return NULL;
+    }
+
+    LectorLp *lector = g_new0(LectorLp, 1);
+    lector->ruta = ruta;
+    lector->archivo = archivo;
+    lector->linea = 1;
+    lector->nueva_linea = TRUE;
+    lector->tipo = MINIMIZACION;
+    lector->texto = g_string_new(NULL);
+    lector->nombres = g_string_chunk_new(4096);
+    lector->indice_columnas = g_hash_table_new(g_str_hash, g_str_equal);
+    lector->nombres_columnas = g_ptr_array_new();
+    lector->c = g_array_new(FALSE, FALSE, sizeof(double));
+    lector->cotas = g_array_new(FALSE, FALSE, sizeof(CotaVariable));
+    lector->coeficientes = g_array_new(FALSE, FALSE, sizeof(CoeficienteLp));
+    lector->tipos_filas = g_array_new(FALSE, FALSE, sizeof(TipoRestriccion));
+    lector->lados_derechos = g_array_new(FALSE, FALSE, sizeof(double));
+
+    leer_archivo(lector);
+    fclose(archivo);
+    Modelo *modelo = lector->error ? NULL : construir_modelo(lector);
+
+    g_free(lector->nombre);
+    g_string_free(lector->texto, TRUE);
+    g_hash_table_destroy(lector->indice_columnas);
+    g_ptr_array_free(lector->nombres_columnas, TRUE);
+    g_array_free(lector->c, TRUE);
+    g_array_free(lector->cotas, TRUE);
+    g_array_free(lector->coeficientes, TRUE);
+    g_array_free(lector->tipos_filas, TRUE);
+    g_array_free(lector->lados_derechos, TRUE);
+    g_string_chunk_free(lector->nombres);
+    g_free(lector);
+    return modelo;
+}
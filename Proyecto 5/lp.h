@@ -0,0 +1,34 @@
+#ifndef LP_H
+#define LP_H
+
+#include <glib.h>
+#include "modelo.h"
+
+G_BEGIN_DECLS
+
+// Lectura de modelos en formato LP (el de CPLEX), pensado para escribirse a mano:
+//
+//     \ Comentario hasta el fin de la línea
+//     Maximize
+//      z: 3 x + 2 y
+//     Subject To
+//      c1: x + y <= 4
+//      c2: x + 3 y >= 2
+//     Bounds
+//      x <= 3
+//      1 <= y <= 10
+//     General
+//      x
+//     End
+//
+// Las cotas se agregan como restricciones igual que en MPS (ver mps.h); las variables
+// que admiten valores negativos (free, cota inferior negativa o -inf) se rechazan.
+// En General y Binary la integralidad se ignora; Binary se lee como 0 <= x <= 1.
+// Una constante distinta de cero en el objetivo es un error, porque el modelo no la representa.
+
+// Prototipos de funciones
+Modelo* modelo_cargar_lp(const char *ruta);
+
+G_END_DECLS
+
+#endif
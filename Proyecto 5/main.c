@@ -7,6 +7,12 @@ Viviana Vargas
 
 #include "simplex.h"
 #include "latex.h"
+#include "modelo.h"
+#include "csv.h"
+#include "compilacion.h"
+#include "cache.h"
+#include "formato.h"
+#include "reporte.h"
 #include <stdio.h>
 #include <sys/types.h>
 #include <signal.h>
@@ -16,7 +22,6 @@ Viviana Vargas
 #include <gtk/gtkx.h>
 #include <math.h>
 #include <ctype.h>
-#include <pthread.h>
 #include <time.h>
 
 GtkWidget *window;
@@ -47,18 +52,25 @@ GtkWidget *sujetoLabel;
 GtkWidget *spinRestrictions;
 GtkWidget *restrictionsScroll;
 GtkWidget *xiLabel;
-GtkWidget *gridRestrictions;
+GtkWidget *treeRestrictions;
 
 GtkWidget *continueButton;
 GtkWidget *loadFileButton;
 GtkWidget *cargarLabel;
 GtkWidget *showTablesCheck;
+GtkWidget *formatCombo;
+GtkWidget *fullIterationsLabel;
+GtkWidget *spinFullIterations;
+GtkWidget *maxColumnsLabel;
+GtkWidget *spinMaxColumns;
 GtkWidget *solveButton;
 GtkWidget *exitButton;
 
 GtkWidget *dantzigImage;
 GtkWidget *saveButton;
 GtkWidget *loadButton;
+GtkWidget *progressBar;
+GtkWidget *cancelButton;
 
 GtkBuilder *builder;
 GtkCssProvider *cssProvider;
@@ -69,7 +81,6 @@ GtkCssProvider *cssProvider;
 
 const char *type = "MAX";
 gboolean showTables = FALSE;
-void compilar_y_mostrar_pdf(const char *nombre_archivo_tex, const char *nombre_archivo_pdf);
 void calcular_soluciones_adicionales(ResultadoSimplex *resultado, ProblemaInfo *info);
 
 typedef struct {
@@ -84,6 +95,41 @@ typedef struct {
 
 static gchar *g_problems_dir = NULL;
 
+// Coeficientes de las restricciones. La tabla de la interfaz no guarda valores: cada
+// fila del GtkListStore solo lleva su índice y las celdas visibles se dibujan desde aquí.
+typedef struct {
+    int num_vars;
+    int num_rest;
+    double *coeficientes;       // La variable j de la fila r está en [r * num_vars + j]
+    double *lados_derechos;
+    TipoRestriccion *tipos;
+} HojaRestricciones;
+
+static HojaRestricciones hoja = { 0 };
+static GtkListStore *storeRestrictions = NULL;
+
+// Un término de Z en ZGrid: "+ [coeficiente] nombre"
+typedef struct {
+    GtkWidget *signo;           // NULL en el primer término
+    GtkWidget *entrada;
+    GtkWidget *etiqueta;
+} TerminoZ;
+
+// Entradas de la interfaz por índice, para no buscarlas en las cuadrículas
+static GPtrArray *entradas_variables = NULL;   // GtkEntry con el nombre de cada variable
+static GArray *terminos_z = NULL;              // TerminoZ de cada variable
+static double *coeficientes_z = NULL;          // Valor de cada entrada de Z, al día con cada edición
+
+// Las entradas se construyen por partes desde un idle: cuántas deben existir
+static int objetivo_variables = 0;
+static int objetivo_z = 0;
+static guint idle_construccion = 0;
+
+#define PRESUPUESTO_IDLE_US 8000    // Tiempo de construcción por vuelta del ciclo principal
+
+#define COLUMNA_LADO_DERECHO (-1)   // Índice de columna de la hoja para el lado derecho
+#define ANCHO_COLUMNA 72
+
 // -------------------------------------------
 // ----------------- Helpers -----------------
 // -------------------------------------------
@@ -153,31 +199,9 @@ static gboolean normalizeValue(GtkWidget *entry, GdkEvent *event, gpointer user_
     return FALSE; 
 }
 
-static GtkWidget* grid_at(GtkWidget *grid, int col, int row) {
-    return gtk_grid_get_child_at(GTK_GRID(grid), col, row);
-}
-
-static double entry_to_double(GtkWidget *w) {
-    if (!w) return 0.0;
-
-    if (GTK_IS_ENTRY(w)) {
-        const char *t = gtk_entry_get_text(GTK_ENTRY(w));
-        if (!t) return 0.0;
-        char *endptr = NULL;
-        return g_ascii_strtod(t, &endptr);   // <-- antes: g_strtod
-    }
-
-    if (GTK_IS_SPIN_BUTTON(w)) {
-        return gtk_spin_button_get_value(GTK_SPIN_BUTTON(w));
-    }
-
-    g_warning("Se esperaba GtkEntry/GtkSpinButton pero se encontró otro widget.");
-    return 0.0;
-}
-
-static int combo_active_index(GtkWidget *maybe_combo) {
-    if (!maybe_combo) return 0;
-    return gtk_combo_box_get_active(GTK_COMBO_BOX(maybe_combo));
+static const char* nombre_variable(int i) {
+    if (i >= (int)entradas_variables->len) return "X?";
+    return gtk_entry_get_text(GTK_ENTRY(g_ptr_array_index(entradas_variables, i)));
 }
 
 static double **alloc_matrix(int rows, int cols) {
@@ -211,151 +235,324 @@ static gchar* filename_from_problem_name(const char *nombre, const char *ext) {
     return out;
 }
 
-static gchar** split_and_trim(const gchar *linea, const gchar *sep, int *count_out) {
-    if (count_out) *count_out = 0;
-    if (!linea) return NULL;
-    gchar **parts = g_strsplit(linea, sep, -1);
-    if (!parts) return NULL;
-    // trim espacios por si acaso
-    for (int i = 0; parts[i]; ++i) {
-        gchar *t = g_strstrip(parts[i]);
-        (void)t;
-        if (count_out) (*count_out)++;
-    }
-    return parts;
-}
-
 // -------------------------------------------
 // ---------------- Funciones ----------------
 // -------------------------------------------
 
-static void clearContainer(GtkWidget *container) {
-    GList *children = gtk_container_get_children(GTK_CONTAINER(container));
-    for (GList *it = children; it != NULL; it = g_list_next(it)) {
-        gtk_widget_destroy(GTK_WIDGET(it->data));
-    }
-    g_list_free(children);
+static void agregar_entrada_variable(int i) {
+    gchar defaultName[16];
+    g_snprintf(defaultName, sizeof(defaultName), "X%d", i + 1);
+
+    GtkWidget *entry = gtk_entry_new();
+    gtk_entry_set_text(GTK_ENTRY(entry), defaultName);
+    gtk_entry_set_alignment(GTK_ENTRY(entry), 0.0); 
+
+    gtk_grid_attach(GTK_GRID(gridVariables), entry, 0, i, 1, 1);
+    gtk_widget_show(entry);
+    g_ptr_array_add(entradas_variables, entry);
 }
 
-void createVariables(GtkSpinButton *spin, gpointer user_data) {
-    int cant = gtk_spin_button_get_value_as_int(spin);
+// Mantiene coeficientes_z al día para leer Z sin recorrer las entradas
+static void coeficiente_z_cambiado(GtkEditable *editable, gpointer data) {
+    coeficientes_z[GPOINTER_TO_INT(data)] = g_ascii_strtod(gtk_entry_get_text(GTK_ENTRY(editable)), NULL);
+}
+
+// El término i ocupa las columnas 3i - 1 ("+"), 3i y 3i + 1, así que agregar o quitar
+// términos al final no mueve los anteriores
+static void agregar_termino_z(int i) {
+    TerminoZ termino = { NULL, NULL, NULL };
+
+    if (i > 0) {
+        termino.signo = gtk_label_new("+");
+        gtk_grid_attach(GTK_GRID(ZGrid), termino.signo, 3*i - 1, 0, 1, 1);
+        gtk_widget_show(termino.signo);
+    }
 
-    GList *children = gtk_container_get_children(GTK_CONTAINER(gridVariables));
-    for (GList *i = children; i != NULL; i = g_list_next(i)) {
-        gtk_widget_destroy(GTK_WIDGET(i->data));
+    termino.entrada = gtk_entry_new();
+    gtk_entry_set_width_chars(GTK_ENTRY(termino.entrada), 6);
+    gtk_entry_set_alignment(GTK_ENTRY(termino.entrada), 1.0);
+    if (coeficientes_z[i] != 0.0) {
+        // Valor puesto por mostrar_modelo antes de que la entrada existiera
+        char buf[BUFNUM];
+        formato_double_exacto(coeficientes_z[i], buf, sizeof(buf));
+        gtk_entry_set_text(GTK_ENTRY(termino.entrada), buf);
     }
-    g_list_free(children);
+    g_signal_connect(termino.entrada, "insert-text", G_CALLBACK(validateEntryNumber), NULL);
+    g_signal_connect(termino.entrada, "focus-out-event", G_CALLBACK(normalizeValue), NULL);
+    g_signal_connect(termino.entrada, "changed", G_CALLBACK(coeficiente_z_cambiado), GINT_TO_POINTER(i));
+    gtk_grid_attach(GTK_GRID(ZGrid), termino.entrada, 3*i, 0, 1, 1);
+    gtk_widget_show(termino.entrada);
+
+    termino.etiqueta = gtk_label_new(nombre_variable(i));
+    gtk_label_set_xalign(GTK_LABEL(termino.etiqueta), 0.0);
+    gtk_grid_attach(GTK_GRID(ZGrid), termino.etiqueta, 3*i + 1, 0, 1, 1);
+    gtk_widget_show(termino.etiqueta);
+
+    g_array_append_val(terminos_z, termino);
+}
 
-    for (int i = 0; i < cant; i++) {
-        gchar defaultName[16];
-        g_snprintf(defaultName, sizeof(defaultName), "X%d", i + 1);
+// Agrega la siguiente entrada pendiente; devuelve FALSE si no queda ninguna.
+// Primero los nombres, porque las etiquetas de Z los usan.
+static gboolean construir_siguiente(void) {
+    if ((int)entradas_variables->len < objetivo_variables) {
+        agregar_entrada_variable(entradas_variables->len);
+        return TRUE;
+    }
+    if ((int)terminos_z->len < objetivo_z) {
+        agregar_termino_z(terminos_z->len);
+        return TRUE;
+    }
+    return FALSE;
+}
 
-        GtkWidget *entry = gtk_entry_new();
-        gtk_entry_set_text(GTK_ENTRY(entry), defaultName);
-        gtk_entry_set_alignment(GTK_ENTRY(entry), 0.0); 
+static gboolean construir_pendientes(gpointer data) {
+    gint64 limite = g_get_monotonic_time() + PRESUPUESTO_IDLE_US;
+    while (construir_siguiente()) {
+        if (g_get_monotonic_time() >= limite) return G_SOURCE_CONTINUE;
+    }
+    idle_construccion = 0;
+    return G_SOURCE_REMOVE;
+}
 
-        gtk_grid_attach(GTK_GRID(gridVariables), entry, 0, i, 1, 1);
+static void programar_construccion(void) {
+    if (!idle_construccion) {
+        idle_construccion = g_idle_add(construir_pendientes, NULL);
     }
+}
 
-    gtk_widget_show_all(gridVariables);
+// Crea en el acto las entradas de nombres que falten, para quien necesita leerlos todos
+static void completar_variables(void) {
+    while ((int)entradas_variables->len < objetivo_variables) {
+        agregar_entrada_variable(entradas_variables->len);
+    }
+}
+
+// Ajusta la lista de nombres a la cantidad pedida: al reducirla se quitan las últimas
+// entradas y al aumentarla las nuevas se construyen en segundo plano
+void createVariables(GtkSpinButton *spin, gpointer user_data) {
+    int cant = MAX(gtk_spin_button_get_value_as_int(spin), 0);
+
+    while ((int)entradas_variables->len > cant) {
+        gtk_widget_destroy(g_ptr_array_index(entradas_variables, entradas_variables->len - 1));
+        g_ptr_array_set_size(entradas_variables, entradas_variables->len - 1);
+    }
+    objetivo_variables = cant;
+    programar_construccion();
 }
 
 static void createZ (void) {
-    int n = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinVariables));
-    if (n <= 0) {
-        clearContainer(ZGrid);
-        gtk_widget_show_all(ZGrid);
-        return;
+    int n = MAX(gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinVariables)), 0);
+    completar_variables();
+
+    while ((int)terminos_z->len > n) {
+        TerminoZ *termino = &g_array_index(terminos_z, TerminoZ, terminos_z->len - 1);
+        if (termino->signo) gtk_widget_destroy(termino->signo);
+        gtk_widget_destroy(termino->entrada);
+        gtk_widget_destroy(termino->etiqueta);
+        g_array_set_size(terminos_z, terminos_z->len - 1);
     }
 
-    clearContainer(ZGrid);
+    // Los términos que quedan conservan su valor y toman los nombres actuales
+    for (guint i = 0; i < terminos_z->len; i++) {
+        gtk_label_set_text(GTK_LABEL(g_array_index(terminos_z, TerminoZ, i).etiqueta), nombre_variable(i));
+    }
 
-    int col = 0; 
+    coeficientes_z = g_renew(double, coeficientes_z, n);
+    for (int i = terminos_z->len; i < n; i++) {
+        coeficientes_z[i] = 0.0;
+    }
+    objetivo_z = n;
+    programar_construccion();
+}
 
-    for (int i = 0; i < n; i++) {
-        GtkWidget *c = gtk_entry_new();
-        gtk_entry_set_width_chars(GTK_ENTRY(c), 6);    
-        gtk_entry_set_alignment(GTK_ENTRY(c), 1.0);
-        g_signal_connect(c, "insert-text", G_CALLBACK(validateEntryNumber), NULL);
-        g_signal_connect(c, "focus-out-event", G_CALLBACK(normalizeValue), NULL);    
-        gtk_grid_attach(GTK_GRID(ZGrid), c, col++, 0, 1, 1);
-
-        GtkWidget *nombreEntry = gtk_grid_get_child_at(GTK_GRID(gridVariables), 0, i);
-        const char *nombreVar = nombreEntry ? gtk_entry_get_text(GTK_ENTRY(nombreEntry)) : "X?";
-        GtkWidget *lblVar = gtk_label_new(nombreVar);
-        gtk_label_set_xalign(GTK_LABEL(lblVar), 0.0);
-        gtk_grid_attach(GTK_GRID(ZGrid), lblVar, col++, 0, 1, 1);
-
-        if (i < n - 1) {
-            GtkWidget *mas = gtk_label_new("+");
-            gtk_grid_attach(GTK_GRID(ZGrid), mas, col++, 0, 1, 1);
+// Cambia la hoja a n × m conservando los valores que siguen dentro; lo nuevo queda en
+// cero y con restricciones ≤
+static void hoja_redimensionar(int n, int m) {
+    if (n != hoja.num_vars) {
+        double *coeficientes = g_new0(double, (gsize)n * m);
+        int comunes = MIN(n, hoja.num_vars);
+        for (int r = 0; r < MIN(m, hoja.num_rest) && comunes > 0; r++) {
+            memcpy(&coeficientes[(gsize)r * n], &hoja.coeficientes[(gsize)r * hoja.num_vars], comunes * sizeof(double));
+        }
+        g_free(hoja.coeficientes);
+        hoja.coeficientes = coeficientes;
+    } else if (m != hoja.num_rest) {
+        // Mismas columnas: las filas están seguidas, así que basta con alargar o recortar
+        hoja.coeficientes = g_renew(double, hoja.coeficientes, (gsize)n * m);
+        if (m > hoja.num_rest) {
+            memset(&hoja.coeficientes[(gsize)hoja.num_rest * n], 0, (gsize)(m - hoja.num_rest) * n * sizeof(double));
         }
     }
 
-    gtk_widget_show_all(ZGrid);
+    hoja.lados_derechos = g_renew(double, hoja.lados_derechos, m);
+    hoja.tipos = g_renew(TipoRestriccion, hoja.tipos, m);
+    for (int r = hoja.num_rest; r < m; r++) {
+        hoja.lados_derechos[r] = 0.0;
+        hoja.tipos[r] = RESTRICCION_LE;
+    }
+    hoja.num_vars = n;
+    hoja.num_rest = m;
 }
 
-static void createRestrictions (void) {
-    int m = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinRestrictions));
-    int n = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinVariables));   
+static double* hoja_celda(int r, int j) {
+    return j == COLUMNA_LADO_DERECHO ? &hoja.lados_derechos[r] : &hoja.coeficientes[(gsize)r * hoja.num_vars + j];
+}
 
-    clearContainer(gridRestrictions);
+static int fila_de_iter(GtkTreeModel *model, GtkTreeIter *iter) {
+    int r = 0;
+    gtk_tree_model_get(model, iter, 0, &r, -1);
+    return r;
+}
 
-    if (m <= 0 || n <= 0) {
-        gtk_widget_show_all(gridRestrictions);
-        return;
+static void dibujar_celda(GtkTreeViewColumn *col, GtkCellRenderer *renderer, GtkTreeModel *model,
+                          GtkTreeIter *iter, gpointer data) {
+    char buf[BUFNUM];
+    formato_double_exacto(*hoja_celda(fila_de_iter(model, iter), GPOINTER_TO_INT(data)), buf, sizeof(buf));
+    g_object_set(renderer, "text", buf, NULL);
+}
+
+static void dibujar_relacion(GtkTreeViewColumn *col, GtkCellRenderer *renderer, GtkTreeModel *model,
+                             GtkTreeIter *iter, gpointer data) {
+    static const char *simbolos[] = { "≤", "≥", "=" };
+    g_object_set(renderer, "text", simbolos[hoja.tipos[fila_de_iter(model, iter)]], NULL);
+}
+
+// Avisa a la vista que la fila cambió para que la vuelva a dibujar
+static void fila_modificada(const gchar *path_string) {
+    GtkTreePath *path = gtk_tree_path_new_from_string(path_string);
+    GtkTreeIter iter;
+    if (gtk_tree_model_get_iter(GTK_TREE_MODEL(storeRestrictions), &iter, path)) {
+        gtk_tree_model_row_changed(GTK_TREE_MODEL(storeRestrictions), path, &iter);
     }
+    gtk_tree_path_free(path);
+}
 
-    for (int r = 0; r < m; r++) {
-        int col = 0;
-
-        for (int i = 0; i < n; i++) {
-            GtkWidget *c = gtk_entry_new();
-            gtk_entry_set_width_chars(GTK_ENTRY(c), 6);
-            gtk_entry_set_alignment(GTK_ENTRY(c), 1.0);
-            gtk_entry_set_text(GTK_ENTRY(c), "0");
-            g_signal_connect(c, "insert-text", G_CALLBACK(validateEntryNumber), NULL);
-            g_signal_connect(c, "focus-out-event", G_CALLBACK(normalizeValue), NULL);
-            gtk_grid_attach(GTK_GRID(gridRestrictions), c, col++, r, 1, 1);
-
-            GtkWidget *nombreEntry = gtk_grid_get_child_at(GTK_GRID(gridVariables), 0, i);
-            const char *nombreVar = nombreEntry ? gtk_entry_get_text(GTK_ENTRY(nombreEntry)) : "X?";
-            GtkWidget *lblVar = gtk_label_new(nombreVar);
-            gtk_label_set_xalign(GTK_LABEL(lblVar), 0.0);
-            gtk_grid_attach(GTK_GRID(gridRestrictions), lblVar, col++, r, 1, 1);
-
-            if (i < n - 1) {
-                GtkWidget *mas = gtk_label_new("+");
-                gtk_grid_attach(GTK_GRID(gridRestrictions), mas, col++, r, 1, 1);
-            }
-        }
+static int fila_de_path(const gchar *path_string) {
+    GtkTreePath *path = gtk_tree_path_new_from_string(path_string);
+    int r = path ? gtk_tree_path_get_indices(path)[0] : -1;
+    gtk_tree_path_free(path);
+    return (r >= 0 && r < hoja.num_rest) ? r : -1;
+}
 
-        // Operador de relación (≤, ≥, =) 
-        GtkWidget *rel = gtk_combo_box_text_new();
-        gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(rel), "≤");
-        gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(rel), "≥");
-        gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(rel), "=");
-        gtk_combo_box_set_active(GTK_COMBO_BOX(rel), 0);
-        gtk_grid_attach(GTK_GRID(gridRestrictions), rel, col++, r, 1, 1);
-
-        // Lado derecho 
-        GtkWidget *rhs = gtk_entry_new();
-        gtk_entry_set_width_chars(GTK_ENTRY(rhs), 8);
-        gtk_entry_set_alignment(GTK_ENTRY(rhs), 1.0);
-        gtk_entry_set_text(GTK_ENTRY(rhs), "0");  
-        g_signal_connect(rhs, "insert-text", G_CALLBACK(validateEntryNumber), NULL);
-        g_signal_connect(rhs, "focus-out-event", G_CALLBACK(normalizeValue), NULL);
-        gtk_grid_attach(GTK_GRID(gridRestrictions), rhs, col++, r, 1, 1);
-        
-        //g_print("Restricción %d creada - Lado derecho en columna: %d\n", r+1, col-1);
+// El editor de la celda usa el mismo filtro numérico que las demás entradas
+static void edicion_iniciada(GtkCellRenderer *renderer, GtkCellEditable *editable, gchar *path, gpointer data) {
+    if (GTK_IS_ENTRY(editable)) {
+        g_signal_connect(editable, "insert-text", G_CALLBACK(validateEntryNumber), NULL);
     }
+}
 
-    gtk_widget_show_all(gridRestrictions);
+static void celda_editada(GtkCellRendererText *renderer, gchar *path, gchar *new_text, gpointer data) {
+    int r = fila_de_path(path);
+    if (r < 0) return;
+    *hoja_celda(r, GPOINTER_TO_INT(data)) = g_ascii_strtod(new_text, NULL);   // Vacío, "-" o "." quedan en 0
+    fila_modificada(path);
 }
 
+// El índice de la opción sigue el orden de TipoRestriccion: ≤, ≥, =
+static void relacion_cambiada(GtkCellRendererCombo *combo, gchar *path, GtkTreeIter *new_iter, gpointer data) {
+    int r = fila_de_path(path);
+    if (r < 0) return;
+
+    GtkTreeModel *opciones = NULL;
+    g_object_get(combo, "model", &opciones, NULL);
+    GtkTreePath *opcion = gtk_tree_model_get_path(opciones, new_iter);
+    hoja.tipos[r] = (TipoRestriccion)gtk_tree_path_get_indices(opcion)[0];
+    gtk_tree_path_free(opcion);
+    g_object_unref(opciones);
+    fila_modificada(path);
+}
+
+static GtkTreeViewColumn* agregar_columna(const char *titulo, GtkCellRenderer *renderer,
+                                          GtkTreeCellDataFunc dibujar, int indice, int posicion) {
+    GtkTreeViewColumn *col = gtk_tree_view_column_new();
+    gtk_tree_view_column_set_title(col, titulo);
+    gtk_tree_view_column_set_sizing(col, GTK_TREE_VIEW_COLUMN_FIXED);
+    gtk_tree_view_column_set_fixed_width(col, ANCHO_COLUMNA);
+    gtk_tree_view_column_pack_start(col, renderer, TRUE);
+    gtk_tree_view_column_set_cell_data_func(col, renderer, dibujar, GINT_TO_POINTER(indice), NULL);
+    gtk_tree_view_insert_column(GTK_TREE_VIEW(treeRestrictions), col, posicion);
+    return col;
+}
+
+static GtkCellRenderer* renderer_numerico(int indice) {
+    GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
+    g_object_set(renderer, "editable", TRUE, "xalign", 1.0, NULL);
+    g_signal_connect(renderer, "editing-started", G_CALLBACK(edicion_iniciada), NULL);
+    g_signal_connect(renderer, "edited", G_CALLBACK(celda_editada), GINT_TO_POINTER(indice));
+    return renderer;
+}
+
+// Crea la tabla de restricciones con las columnas fijas (operador y lado derecho); las
+// de las variables las agrega createRestrictions delante de ellas. Con filas de alto
+// fijo la vista solo crea y mide lo que está en pantalla.
+static void crear_tabla_restricciones(void) {
+    storeRestrictions = gtk_list_store_new(1, G_TYPE_INT);
+    treeRestrictions = gtk_tree_view_new_with_model(GTK_TREE_MODEL(storeRestrictions));
+    gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(treeRestrictions), TRUE);
+    gtk_tree_view_set_grid_lines(GTK_TREE_VIEW(treeRestrictions), GTK_TREE_VIEW_GRID_LINES_BOTH);
+    gtk_tree_view_set_enable_search(GTK_TREE_VIEW(treeRestrictions), FALSE);
+
+    // Operador de relación (≤, ≥, =)
+    GtkListStore *opciones = gtk_list_store_new(1, G_TYPE_STRING);
+    gtk_list_store_insert_with_values(opciones, NULL, -1, 0, "≤", -1);
+    gtk_list_store_insert_with_values(opciones, NULL, -1, 0, "≥", -1);
+    gtk_list_store_insert_with_values(opciones, NULL, -1, 0, "=", -1);
+    GtkCellRenderer *rel = gtk_cell_renderer_combo_new();
+    g_object_set(rel, "model", opciones, "text-column", 0, "has-entry", FALSE, "editable", TRUE, "xalign", 0.5, NULL);
+    g_signal_connect(rel, "changed", G_CALLBACK(relacion_cambiada), NULL);
+    g_object_unref(opciones);
+    agregar_columna("", rel, dibujar_relacion, 0, -1);
+
+    // Lado derecho
+    agregar_columna("b", renderer_numerico(COLUMNA_LADO_DERECHO), dibujar_celda, COLUMNA_LADO_DERECHO, -1);
+}
+
+// Ajusta la tabla a las cantidades pedidas tocando solo lo que cambia: pasar de 50 a 51
+// restricciones agrega una fila y los valores ya escritos se conservan
+static void createRestrictions (void) {
+    int m = MAX(gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinRestrictions)), 0);
+    int n = MAX(gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinVariables)), 0);
+    GtkTreeView *vista = GTK_TREE_VIEW(treeRestrictions);
+    GtkTreeModel *model = GTK_TREE_MODEL(storeRestrictions);
+    completar_variables();
+
+    if (m == 0 || n == 0) {
+        m = 0;
+        n = 0;
+    }
+
+    // Filas de más: se quitan desde el final, antes de achicar la hoja
+    GtkTreeIter iter;
+    int filas = gtk_tree_model_iter_n_children(model, NULL);
+    while (filas > m && gtk_tree_model_iter_nth_child(model, &iter, NULL, filas - 1)) {
+        gtk_list_store_remove(storeRestrictions, &iter);
+        filas--;
+    }
+
+    hoja_redimensionar(n, m);
+
+    // Columnas de variables: van antes del operador y del lado derecho
+    int columnas = (int)gtk_tree_view_get_n_columns(vista) - 2;
+    for (int i = columnas - 1; i >= n; i--) {
+        gtk_tree_view_remove_column(vista, gtk_tree_view_get_column(vista, i));
+    }
+    for (int i = 0; i < MIN(columnas, n); i++) {
+        gtk_tree_view_column_set_title(gtk_tree_view_get_column(vista, i), nombre_variable(i));
+    }
+    for (int i = columnas; i < n; i++) {
+        agregar_columna(nombre_variable(i), renderer_numerico(i), dibujar_celda, i, i);
+    }
+
+    for (int r = filas; r < m; r++) {
+        gtk_list_store_insert_with_values(storeRestrictions, NULL, -1, 0, r, -1);
+    }
+
+    gtk_widget_set_visible(treeRestrictions, n > 0);
+    gtk_widget_queue_draw(treeRestrictions);
+}
 
-// Función para construir el problema simplex desde la interfaz
-static ResultadoSimplex* construir_y_resolver_simplex(void) {
+// Función para tomar una copia del problema escrito en la interfaz
+static Modelo* leer_modelo_desde_interfaz(void) {
     int n = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinVariables));
     int m = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinRestrictions));
     
@@ -363,64 +560,29 @@ static ResultadoSimplex* construir_y_resolver_simplex(void) {
         return NULL;
     }
     
+    completar_variables();
     TipoProblema tipo = (strcmp(type, "MAX") == 0) ? MAXIMIZACION : MINIMIZACION;
-    TablaSimplex *tabla = crear_tabla_simplex(n, m, tipo);
+    Modelo *modelo = modelo_nuevo(gtk_entry_get_text(GTK_ENTRY(nameEntry)), tipo, n, m);
     
-    // Establecer función objetivo
-    double *coef_obj = g_new0(double, n);
     for (int i = 0; i < n; i++) {
-        GtkWidget *coef_entry = grid_at(ZGrid, 3*i, 0);
-        if (coef_entry && GTK_IS_ENTRY(coef_entry)) {
-            coef_obj[i] = entry_to_double(coef_entry);
-        } else {
-            coef_obj[i] = 0.0;
-        }
+        modelo_establecer_nombre_variable(modelo, i, nombre_variable(i));
     }
-    establecer_funcion_objetivo(tabla, coef_obj);
-    g_free(coef_obj);
     
-    // Leer restricciones
-    for (int r = 0; r < m; r++) {
-        double *coef_rest = g_new0(double, n);
-        double lado_derecho = 0.0;
-        TipoRestriccion tipo_rest = RESTRICCION_LE;
-        
-        // Leer coeficientes
-        for (int i = 0; i < n; i++) {
-            GtkWidget *coef_entry = grid_at(gridRestrictions, 3*i, r);
-            if (coef_entry && GTK_IS_ENTRY(coef_entry)) {
-                coef_rest[i] = entry_to_double(coef_entry);
-            } else {
-                coef_rest[i] = 0.0;
-            }
-        }
-        
-        // Leer tipo de restricción
-        GtkWidget *rel = grid_at(gridRestrictions, 3*n - 1, r);
-        int tipo_idx = combo_active_index(rel);
-        switch (tipo_idx) {
-            case 0: tipo_rest = RESTRICCION_LE; break;  // ≤
-            case 1: tipo_rest = RESTRICCION_GE; break;  // ≥
-            case 2: tipo_rest = RESTRICCION_EQ; break;  // =
-        }
-        
-        // Leer lado derecho
-        int rhs_col = 3 * n;
-        GtkWidget *rhs_entry = grid_at(gridRestrictions, rhs_col, r);
-        if (rhs_entry && GTK_IS_ENTRY(rhs_entry)) {
-            lado_derecho = entry_to_double(rhs_entry);
-        } else {
-            lado_derecho = 0.0;
-        }
-        
-        agregar_restriccion(tabla, r, coef_rest, lado_derecho, tipo_rest);
-        g_free(coef_rest);
+    // Función objetivo
+    for (int i = 0; i < MIN(n, objetivo_z); i++) {
+        modelo->c[i] = coeficientes_z[i];
     }
     
-    ResultadoSimplex *resultado = resolver_simplex(tabla, showTables);
-    liberar_tabla_simplex(tabla);
+    // Restricciones: lo que no esté en la hoja (cantidades cambiadas sin continuar) queda en 0
+    for (int r = 0; r < MIN(m, hoja.num_rest); r++) {
+        for (int i = 0; i < MIN(n, hoja.num_vars); i++) {
+            modelo->A[r][i] = *hoja_celda(r, i);
+        }
+        modelo->tipos_restricciones[r] = hoja.tipos[r];
+        modelo->lados_derechos[r] = hoja.lados_derechos[r];
+    }
     
-    return resultado;
+    return modelo;
 }
 
 // Función para calcular soluciones adicionales (en main.c)
@@ -428,11 +590,11 @@ void calcular_soluciones_adicionales(ResultadoSimplex *resultado, ProblemaInfo *
     if (!resultado || resultado->tipo_solucion != SOLUCION_MULTIPLE) return;
     
     resultado->num_soluciones_adicionales = 3;
-    resultado->soluciones_adicionales = g_new0(double*, 3);
+    resultado->soluciones_adicionales = arena_new0(resultado->arena, double*, 3);
     
     // Crear soluciones adicionales (esto es un ejemplo simplificado)
     for (int k = 0; k < 3; k++) {
-        resultado->soluciones_adicionales[k] = g_new0(double, info->num_vars);
+        resultado->soluciones_adicionales[k] = arena_new0(resultado->arena, double, info->num_vars);
         for (int i = 0; i < info->num_vars; i++) {
             // Distribuir valores alrededor de la solución óptima
             resultado->soluciones_adicionales[k][i] = resultado->solucion[i] * (0.7 + 0.3 * k);
@@ -440,76 +602,15 @@ void calcular_soluciones_adicionales(ResultadoSimplex *resultado, ProblemaInfo *
     }
 }
 
-// Escribe el CSV en 'filepath'
-static gboolean setCSVPath(const char *filepath) {
-    if (!filepath) return FALSE;
-    char buf[BUFNUM];
-
-    int n = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinVariables));
-    int m = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinRestrictions));
-    if (n <= 0 || m < 0) return FALSE;
-
-    FILE *f = fopen(filepath, "w");
-    if (!f) return FALSE;
-
-    // NAME
-    const char *nombre = gtk_entry_get_text(GTK_ENTRY(nameEntry));
-    if (!nombre || !*nombre) nombre = "Problema";
-    fprintf(f, "NAME,%s\n", nombre);
-
-    // TYPE
-    fprintf(f, "TYPE,%s\n", (type && strcmp(type, "MIN")==0) ? "MIN" : "MAX");
-
-    // N y VARS
-    fprintf(f, "N,%d\n", n);
-    fprintf(f, "VARS");
-    for (int i = 0; i < n; ++i) {
-        GtkWidget *e = grid_at(gridVariables, 0, i);
-        const char *v = (e && GTK_IS_ENTRY(e)) ? gtk_entry_get_text(GTK_ENTRY(e)) : "X?";
-        fprintf(f, ",%s", v);
-    }
-    fprintf(f, "\n");
-
-    // M
-    fprintf(f, "M,%d\n", m);
-
-    // Z (detecta si hay label al inicio o no)
-    fprintf(f, "Z");
-    int z_base = 0;
-    for (int i = 0; i < n; ++i) {
-        GtkWidget *coef_entry = grid_at(ZGrid, z_base + 3*i, 0);
-        double c = entry_to_double(coef_entry);
-        g_ascii_formatd(buf, sizeof(buf), "%.17g", c);
-        fprintf(f, ",%s", buf);
-    }
-    fprintf(f, "\n");
-
-    // Restricciones
-    for (int r = 0; r < m; ++r) {
-        fprintf(f, "R");
-        for (int i = 0; i < n; ++i) {
-            GtkWidget *coef_entry = grid_at(gridRestrictions, 0 + 3*i, r);
-            double aij = entry_to_double(coef_entry);
-            g_ascii_formatd(buf, sizeof(buf), "%.17g", aij);
-            fprintf(f, ",%s", buf);
-        }
-        GtkWidget *rel = grid_at(gridRestrictions, 3*n - 1, r);
-        int idx = combo_active_index(rel); // 0: ≤, 1: ≥, 2: =
-        const char *op = (idx==0) ? "<=" : (idx==1) ? ">=" : "=";
-
-        GtkWidget *rhs_entry = grid_at(gridRestrictions, 3*n, r);
-        double b = entry_to_double(rhs_entry);
-        g_ascii_formatd(buf, sizeof(buf), "%.17g", b);
-        fprintf(f, ",%s,%s\n", op, buf);
-    }
-    fclose(f);
-    return TRUE;
+// Escribe el CSV del modelo en 'filepath'
+static gboolean setCSVPath(const char *filepath, const Modelo *modelo) {
+    if (!filepath || !modelo) return FALSE;
+    return modelo_guardar_csv(modelo, filepath);
 }
 
 // Guardar problema en .csv
-static gboolean saveToCsv(void) {
-    const char *nombre = gtk_entry_get_text(GTK_ENTRY(nameEntry));
-    gchar *fname = filename_from_problem_name(nombre, "csv");
+static gboolean saveToCsv(const Modelo *modelo) {
+    gchar *fname = filename_from_problem_name(modelo->nombre, "csv");
 
     if (!g_problems_dir) {
         gchar *base_dir = g_get_current_dir();
@@ -520,7 +621,7 @@ static gboolean saveToCsv(void) {
 
     gchar *filepath = g_build_filename(g_problems_dir, fname, NULL);
 
-    gboolean ok = setCSVPath(filepath);
+    gboolean ok = setCSVPath(filepath, modelo);
 
     if (!ok) {
         GtkWidget *err = gtk_message_dialog_new(
@@ -537,89 +638,36 @@ static gboolean saveToCsv(void) {
     return ok;
 }
 
-// Cargar problema a interfaz
-static gboolean loadFromCSV(const char *filepath) {
-    if (!filepath) return FALSE;
-
-    gchar *contents = NULL;
-    gsize len = 0;
-    if (!g_file_get_contents(filepath, &contents, &len, NULL)) return FALSE;
-
-    gchar **lines = g_strsplit(contents, "\n", -1);
-    if (!lines) { g_free(contents); return FALSE; }
-
-    GPtrArray *vars       = g_ptr_array_new_with_free_func(g_free);
-    GPtrArray *rest_filas = g_ptr_array_new_with_free_func((GDestroyNotify)g_strfreev);
-    gchar *prob_name = NULL;
-    gchar *tipo_str  = NULL;
-    int n = -1, m = -1;
-    double *z = NULL;
-
-    for (int i = 0; lines[i]; ++i) {
-        gchar *line = g_strstrip(lines[i]);
-        if (!*line) continue;
-
-        int cnt = 0;
-        gchar **parts = split_and_trim(line, ",", &cnt);
-        if (!parts || cnt == 0) { if (parts) g_strfreev(parts); continue; }
-
-        if (g_strcmp0(parts[0], "NAME")==0 && cnt >= 2) {
-            g_free(prob_name);  
-            prob_name = g_strdup(parts[1]);
-        } else if (g_strcmp0(parts[0], "TYPE")==0 && cnt >= 2) {
-            g_free(tipo_str);
-            tipo_str = g_strdup(parts[1]);
-        } else if (g_strcmp0(parts[0], "N")==0 && cnt >= 2) {
-            n = atoi(parts[1]);
-        } else if (g_strcmp0(parts[0], "VARS")==0 && cnt >= 2) {
-            for (int k = 1; k < cnt; ++k) g_ptr_array_add(vars, g_strdup(parts[k]));
-        } else if (g_strcmp0(parts[0], "M")==0 && cnt >= 2) {
-            m = atoi(parts[1]);
-        } else if (g_strcmp0(parts[0], "Z")==0 && n > 0) {
-            g_free(z);
-            z = g_new0(double, n);
-            for (int k = 0; k < n && (k+1) < cnt; ++k) z[k] = g_ascii_strtod(parts[k+1], NULL);
-        } else if (g_strcmp0(parts[0], "R")==0) {
-            g_ptr_array_add(rest_filas, parts);
-            parts = NULL;
-        }
-
-        if (parts) g_strfreev(parts);
-    }
-
-    // Validación básica
-    gboolean ok = TRUE;
-    if (n <= 0 || m < 0 || (int)vars->len != n || !z) ok = FALSE;
-
-    if (!ok) {
-        g_free(z);
-        g_free(prob_name);
-        g_free(tipo_str);
-        g_ptr_array_free(rest_filas, TRUE); // libera cada R con g_strfreev
-        g_ptr_array_free(vars, TRUE);       // libera cada var con g_free
-        g_strfreev(lines);
-        g_free(contents);
-        return FALSE;
-    }
+// Muestra en la interfaz un problema ya cargado; los valores se copian del modelo
+static void mostrar_modelo(const Modelo *modelo) {
+    int n = modelo->num_vars;
+    int m = modelo->num_rest;
+    char buf[BUFNUM];
 
-    // Cargar a Interfaz
     // Tipo
-    if (tipo_str && g_ascii_strcasecmp(tipo_str, "MIN")==0) {
+    if (modelo->tipo == MINIMIZACION) {
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(rbMinimizar), TRUE);
     } else {
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(rbMaximizar), TRUE);
     }
 
     // Nombre
-    if (prob_name) gtk_entry_set_text(GTK_ENTRY(nameEntry), prob_name);
+    gtk_entry_set_text(GTK_ENTRY(nameEntry), modelo->nombre);
+
+    // Los archivos pueden traer más variables o restricciones que las del glade
+    GtkAdjustment *ajuste_vars = gtk_spin_button_get_adjustment(GTK_SPIN_BUTTON(spinVariables));
+    GtkAdjustment *ajuste_rest = gtk_spin_button_get_adjustment(GTK_SPIN_BUTTON(spinRestrictions));
+    gtk_adjustment_set_lower(ajuste_vars, MIN(gtk_adjustment_get_lower(ajuste_vars), n));
+    gtk_adjustment_set_upper(ajuste_vars, MAX(gtk_adjustment_get_upper(ajuste_vars), n));
+    gtk_adjustment_set_lower(ajuste_rest, MIN(gtk_adjustment_get_lower(ajuste_rest), m));
+    gtk_adjustment_set_upper(ajuste_rest, MAX(gtk_adjustment_get_upper(ajuste_rest), m));
 
     // Variables
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(spinVariables), n);
     createVariables(GTK_SPIN_BUTTON(spinVariables), NULL);
-    for (int i = 0; i < n; ++i) {
-        GtkWidget *e = grid_at(gridVariables, 0, i);
-        const char *vname = g_ptr_array_index(vars, i);
-        if (e && GTK_IS_ENTRY(e) && vname) gtk_entry_set_text(GTK_ENTRY(e), vname);
+    completar_variables();
+    for (int i = 0; i < MIN(n, (int)entradas_variables->len); ++i) {
+        gtk_entry_set_text(GTK_ENTRY(g_ptr_array_index(entradas_variables, i)), modelo->nombres_vars[i]);
     }
 
     // Restricciones
@@ -628,63 +676,22 @@ static gboolean loadFromCSV(const char *filepath) {
 
     // Z
     createZ();
-    int z_base = 0;
-    GtkWidget *c00 = grid_at(ZGrid, 0, 0);
-    if (c00 && GTK_IS_LABEL(c00)) z_base = 1;
-
-    char buf[BUFNUM];
+    // Los términos que aún no existen toman su valor de coeficientes_z al construirse
     for (int i = 0; i < n; ++i) {
-        GtkWidget *coef_entry = grid_at(ZGrid, z_base + 3*i, 0);
-        if (coef_entry && GTK_IS_ENTRY(coef_entry)) {
-            g_ascii_formatd(buf, sizeof(buf), "%.17g", z[i]);
-            gtk_entry_set_text(GTK_ENTRY(coef_entry), buf);
+        coeficientes_z[i] = modelo->c[i];
+        if (i < (int)terminos_z->len) {
+            formato_double_exacto(modelo->c[i], buf, sizeof(buf));
+            gtk_entry_set_text(GTK_ENTRY(g_array_index(terminos_z, TerminoZ, i).entrada), buf);
         }
     }
 
-    // Filas R
-    int m_csv = MIN(m, (int)rest_filas->len);
-    for (int r = 0; r < m_csv; ++r) {
-        gchar **R = g_ptr_array_index(rest_filas, r);
-        if (!R) continue;
-        int cntR = 0; while (R[cntR]) cntR++;
-
-        // coeficientes
-        for (int i = 0; i < n; ++i) {
-            GtkWidget *coef_entry = grid_at(gridRestrictions, 0 + 3*i, r);
-            double aij = g_ascii_strtod(R[1+i], NULL);
-            if (coef_entry && GTK_IS_ENTRY(coef_entry)) {
-                g_ascii_formatd(buf, sizeof(buf), "%.17g", aij);
-                gtk_entry_set_text(GTK_ENTRY(coef_entry), buf);
-            }
-        }
-
-        const char *op   = R[1+n];
-        const char *btxt = (cntR >= 3+n) ? R[2+n] : "0";
-
-        int idx = 0;
-        if (op && strcmp(op, ">=")==0) idx = 1;
-        else if (op && strcmp(op, "=")==0) idx = 2;
-
-        GtkWidget *rel = grid_at(gridRestrictions, 3*n - 1, r);
-        if (rel && GTK_IS_COMBO_BOX(rel)) gtk_combo_box_set_active(GTK_COMBO_BOX(rel), idx);
-
-        GtkWidget *rhs_entry = grid_at(gridRestrictions, 3*n, r);
-        if (rhs_entry && GTK_IS_ENTRY(rhs_entry)) {
-            double bval = g_ascii_strtod(btxt, NULL);
-            g_ascii_formatd(buf, sizeof(buf), "%.17g", bval);
-            gtk_entry_set_text(GTK_ENTRY(rhs_entry), buf);
-        }
+    // Restricciones: se copian a la hoja y la vista dibuja lo visible
+    for (int r = 0; r < hoja.num_rest; ++r) {
+        memcpy(hoja_celda(r, 0), modelo->A[r], n * sizeof(double));
+        hoja.tipos[r] = modelo->tipos_restricciones[r];
+        hoja.lados_derechos[r] = modelo->lados_derechos[r];
     }
-
-    g_free(z);
-    g_free(prob_name);
-    g_free(tipo_str);
-    g_ptr_array_free(rest_filas, TRUE);
-    g_ptr_array_free(vars, TRUE);
-    g_strfreev(lines);
-    g_free(contents);
-
-    return TRUE;
+    gtk_widget_queue_draw(treeRestrictions);
 }
 
 // -------------------------------------------
@@ -732,41 +739,191 @@ void on_loadFileButton_file_set(GtkWidget *widget, gpointer data) {
     if (filename) g_free(filename);
 }
 
-void on_solveButton_clicked(GtkWidget *widget, gpointer data) {
+// -------------------------------------------
+// ------ Resolución en segundo plano --------
+// -------------------------------------------
 
-    saveToCsv();
-    int n = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinVariables));
-    int m = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinRestrictions));
+// Todo lo que necesita el hilo de trabajo; no toca widgets
+typedef struct {
+    Modelo *modelo;                  // Copia tomada al pulsar Resolver; solo se lee
+    gboolean mostrar_tablas;
+    OpcionesReporte opciones;        // Límites del reporte; 0 = sin límite
+    FormatoReporte formato;
+    gchar *ruta_salida;              // El .tex a compilar, o el reporte HTML/Markdown
+    gchar *clave;                    // Hash del modelo para la caché de reportes
+    ResultadoSimplex *resultado;
+    gboolean reporte_listo;
+    CompilacionLatex *compilacion;   // Solo se usa desde el hilo de la interfaz
+    gint cancelado;
+} TrabajoSimplex;
+
+static ContextoSimplex *contexto_gui = NULL;
+static TrabajoSimplex *trabajo_actual = NULL;
+
+static gint avance_pendiente = 0;   // Evita llenar la cola de la interfaz con avances
+
+// Muestra en la barra el texto enviado por el hilo de trabajo
+static gboolean mostrar_avance(gpointer datos) {
+    gchar *texto = datos;
+    if (trabajo_actual) {
+        gtk_progress_bar_pulse(GTK_PROGRESS_BAR(progressBar));
+        gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progressBar), texto);
+    }
+    g_atomic_int_set(&avance_pendiente, 0);
+    g_free(texto);
+    return G_SOURCE_REMOVE;
+}
+
+// Se llama desde el hilo de trabajo para avances que siempre deben mostrarse
+static void publicar_avance(gchar *texto) {
+    g_atomic_int_set(&avance_pendiente, 1);
+    g_idle_add(mostrar_avance, texto);
+}
+
+// Se llama en cada iteración: si la interfaz todavía no mostró el avance anterior, este
+// se descarta antes de formatearlo, para no reservar memoria en cada pivote
+static void progreso_resolucion(const ProgresoSimplex *progreso, gpointer datos) {
+    if (!g_atomic_int_compare_and_exchange(&avance_pendiente, 0, 1)) return;
+    g_idle_add(mostrar_avance, g_strdup_printf("Iteración %d  (Z = %.4g)", progreso->iteracion, progreso->valor_z));
+}
+
+// Libera el trabajo y devuelve la interfaz a su estado normal
+static void finalizar_trabajo(TrabajoSimplex *trabajo) {
+    if (trabajo->resultado && trabajo->resultado->tipo_solucion == SOLUCION_INTERRUMPIDA) {
+        // Sin bloquear: el diálogo se cierra solo al responder
+        GtkWidget *aviso = gtk_message_dialog_new(GTK_WINDOW(window), GTK_DIALOG_DESTROY_WITH_PARENT,
+                                                  GTK_MESSAGE_INFO, GTK_BUTTONS_OK,
+                                                  "%s", trabajo->resultado->mensaje);
+        gtk_window_set_title(GTK_WINDOW(aviso), "Resolución interrumpida");
+        g_signal_connect_swapped(aviso, "response", G_CALLBACK(gtk_widget_destroy), aviso);
+        gtk_widget_show(aviso);
+    }
     
-    if (n <= 0) {
-        return;
+    contexto_simplex_reciclar_resultado(contexto_gui, trabajo->resultado);
+    modelo_liberar(trabajo->modelo);
+    g_free(trabajo->ruta_salida);
+    g_free(trabajo->clave);
+    g_free(trabajo);
+    trabajo_actual = NULL;
+    
+    gtk_widget_hide(progressBar);
+    gtk_widget_hide(cancelButton);
+    gtk_widget_set_sensitive(solveButton, TRUE);
+}
+
+// Un PDF con errores de LaTeX se abre igual (suele estar completo salvo detalles),
+// pero no se guarda en la caché: la próxima vez se vuelve a compilar
+static void compilacion_terminada(const char *ruta_pdf, EstadoCompilacion estado, gpointer datos) {
+    TrabajoSimplex *trabajo = datos;
+    if (estado == COMPILACION_CORRECTA) {
+        cache_reporte_guardar(trabajo->clave, ruta_pdf);
     }
+    if (estado != COMPILACION_FALLIDA) {
+        abrir_pdf(ruta_pdf);
+    }
+    finalizar_trabajo(trabajo);
+}
+
+// Abre el reporte HTML o Markdown con la aplicación predeterminada del sistema
+static void abrir_reporte(const char *ruta) {
+    GError *error = NULL;
+    gchar *uri = g_filename_to_uri(ruta, NULL, &error);
     
-    if (m <= 0) {
-        return;
+    if (!uri || !g_app_info_launch_default_for_uri(uri, NULL, &error)) {
+        g_printerr("Error: No se pudo abrir el reporte: %s\n", error->message);
+        g_error_free(error);
+    } else {
+        g_print("Reporte generado y abierto: %s\n", ruta);
     }
+    g_free(uri);
+}
+
+// De vuelta en el hilo de la interfaz: lanzar la compilación sin bloquear
+static gboolean reporte_generado(gpointer datos) {
+    TrabajoSimplex *trabajo = datos;
     
-    gboolean todas_menor_igual = TRUE;
-    for (int r = 0; r < m; r++) {
-        GtkWidget *rel = grid_at(gridRestrictions, 3*n - 1, r);
-        int tipo_rest = combo_active_index(rel);
-        if (tipo_rest != 0) {
-            todas_menor_igual = FALSE;
-            break;
+    if (!trabajo->reporte_listo || g_atomic_int_get(&trabajo->cancelado)) {
+        finalizar_trabajo(trabajo);
+        return G_SOURCE_REMOVE;
+    }
+    
+    // HTML y Markdown no se compilan: se abren tal cual
+    if (trabajo->formato != REPORTE_PDF) {
+        abrir_reporte(trabajo->ruta_salida);
+        finalizar_trabajo(trabajo);
+        return G_SOURCE_REMOVE;
+    }
+    
+    gtk_progress_bar_pulse(GTK_PROGRESS_BAR(progressBar));
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progressBar), "Compilando PDF...");
+    trabajo->compilacion = compilar_latex_async(trabajo->ruta_salida, compilacion_terminada, trabajo);
+    return G_SOURCE_REMOVE;
+}
+
+// Hilo de trabajo: resolver y generar el reporte
+static gpointer hilo_resolver(gpointer datos) {
+    TrabajoSimplex *trabajo = datos;
+    
+    TablaSimplex *tabla = modelo_a_tabla(trabajo->modelo);
+    trabajo->resultado = resolver_simplex_contexto(contexto_gui, tabla, trabajo->mostrar_tablas);
+    liberar_tabla_simplex(tabla);
+    
+    if (trabajo->resultado->tipo_solucion != SOLUCION_INTERRUMPIDA) {
+        ProblemaInfo info;
+        modelo_a_info(trabajo->modelo, &info);
+        
+        if (trabajo->resultado->tipo_solucion == SOLUCION_MULTIPLE) {
+            calcular_soluciones_adicionales(trabajo->resultado, &info);
         }
+        
+        // Si no se pudo escribir completo, reporte_generado no compila ni abre nada
+        publicar_avance(g_strdup(trabajo->formato == REPORTE_PDF ? "Generando reporte LaTeX..." : "Generando reporte..."));
+        trabajo->reporte_listo = generar_reporte(trabajo->formato, trabajo->resultado, &info, trabajo->ruta_salida,
+                                                 trabajo->mostrar_tablas, &trabajo->opciones);
+    }
+    
+    g_idle_add(reporte_generado, trabajo);
+    return NULL;
+}
+
+void on_cancelButton_clicked(GtkWidget *widget, gpointer data) {
+    if (!trabajo_actual) return;
+    
+    g_atomic_int_set(&trabajo_actual->cancelado, 1);
+    contexto_simplex_cancelar(contexto_gui);
+    compilacion_latex_cancelar(trabajo_actual->compilacion);
+    gtk_widget_set_sensitive(cancelButton, FALSE);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progressBar), "Cancelando...");
+}
+
+void on_solveButton_clicked(GtkWidget *widget, gpointer data) {
+    if (trabajo_actual) return;
+
+    // La interfaz se lee una sola vez: el CSV, el hilo de trabajo (tabla y reporte) y la
+    // caché usan esta copia, que nadie modifica hasta que el trabajo la libera
+    Modelo *modelo = leer_modelo_desde_interfaz();
+    if (!modelo) {
+        return;
+    }
+
+    saveToCsv(modelo);
+    
+    if (modelo->num_rest <= 0) {
+        modelo_liberar(modelo);
+        return;
     }
 
     gboolean todos_no_negativos = TRUE;
-    for (int r = 0; r < m; r++) {
-        GtkWidget *rhs_entry = grid_at(gridRestrictions, 3*n, r);
-        double b = entry_to_double(rhs_entry);
-        if (b < 0) {
+    for (int r = 0; r < modelo->num_rest; r++) {
+        if (modelo->lados_derechos[r] < 0) {
             todos_no_negativos = FALSE;
             break;
         }
     }
 
     if (!todos_no_negativos) {
+        modelo_liberar(modelo);
+        
         GtkWindow *win = NULL;
         GtkWidget *top = gtk_widget_get_toplevel(widget);
         if (GTK_IS_WINDOW(top)) win = GTK_WINDOW(top);
@@ -785,122 +942,80 @@ void on_solveButton_clicked(GtkWidget *widget, gpointer data) {
         return;
     }
     
-    ResultadoSimplex *resultado = construir_y_resolver_simplex();
-
-    if (resultado) {
-        const char **nombres_vars = g_new0(const char*, n);
-        for (int i = 0; i < n; i++) {
-            GtkWidget *entry = grid_at(gridVariables, 0, i);
-            if (entry && GTK_IS_ENTRY(entry)) {
-                nombres_vars[i] = gtk_entry_get_text(GTK_ENTRY(entry));
-            } else {
-                nombres_vars[i] = "X?";
+    // El orden de las opciones del combo es el de FormatoReporte
+    FormatoReporte formato = (FormatoReporte)MAX(gtk_combo_box_get_active(GTK_COMBO_BOX(formatCombo)), 0);
+    // Por defecto (0 y 0) el reporte es completo; en problemas grandes se pueden acotar
+    OpcionesReporte opciones = {
+        gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinFullIterations)),
+        gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spinMaxColumns))
+    };
+    char nombre_archivo_tex[256];
+    char nombre_archivo_pdf[256];
+    char nombre_archivo_reporte[256];
+    const char *nombre_ingresado = modelo->nombre;
+
+    if (nombre_ingresado && strlen(nombre_ingresado) > 0) {
+        char nombre_limpio[200];
+        int j = 0;
+        for (int i = 0; nombre_ingresado[i] != '\0' && j < 195; i++) {
+            if (isalnum(nombre_ingresado[i]) || nombre_ingresado[i] == '_' || nombre_ingresado[i] == '-') {
+                nombre_limpio[j++] = nombre_ingresado[i];
+            } else if (nombre_ingresado[i] == ' ') {
+                nombre_limpio[j++] = '_';
             }
         }
-        
-        ProblemaInfo info;
-        info.nombres_vars = nombres_vars;
-        info.num_vars = n;
-        info.num_rest = m;
-
-        info.tipos_restricciones = g_new0(TipoRestriccion, m);
-        for (int r = 0; r < m; r++) {
-            GtkWidget *rel = grid_at(gridRestrictions, 3*n - 1, r);
-            int tipo_rest = combo_active_index(rel);
-            
-            // Convertir el índice del combo box al TipoRestriccion
-            switch (tipo_rest) {
-                case 0:  // "<="
-                    info.tipos_restricciones[r] = RESTRICCION_LE;
-                    break;
-                case 1:  // ">="  
-                    info.tipos_restricciones[r] = RESTRICCION_GE;
-                    break;
-                case 2:  // "="
-                    info.tipos_restricciones[r] = RESTRICCION_EQ;
-                    break;
-                default:
-                    info.tipos_restricciones[r] = RESTRICCION_LE; // Por defecto
-                    break;
-            }
+        nombre_limpio[j] = '\0';
+        if (strlen(nombre_limpio) == 0) {
+            snprintf(nombre_limpio, sizeof(nombre_limpio), "simplex_resultado");
         }
+        snprintf(nombre_archivo_tex, sizeof(nombre_archivo_tex), "%s.tex", nombre_limpio);
+        snprintf(nombre_archivo_pdf, sizeof(nombre_archivo_pdf), "%s.pdf", nombre_limpio);
+        snprintf(nombre_archivo_reporte, sizeof(nombre_archivo_reporte), "%s.%s", nombre_limpio, extension_reporte(formato));
         
-        const char *nombre_problema = gtk_entry_get_text(GTK_ENTRY(nameEntry));
-        info.nombre_problema = (nombre_problema && strlen(nombre_problema) > 0) ? 
-                              nombre_problema : "Problema de Optimización";
-        info.tipo_problema = type;
-        
-        info.coef_obj = g_new0(double, n);
-        int z_base = 0;
-        GtkWidget *c00 = grid_at(ZGrid, 0, 0);
-        if (c00 && GTK_IS_LABEL(c00)) z_base = 1;
-        
-        for (int i = 0; i < n; i++) {
-            GtkWidget *coef_entry = grid_at(ZGrid, z_base + 3*i, 0);
-            info.coef_obj[i] = entry_to_double(coef_entry);
-        }
-        
-        info.coef_rest = g_new0(double*, m);
-        info.lados_derechos = g_new0(double, m);
-        
-        for (int r = 0; r < m; r++) {
-            info.coef_rest[r] = g_new0(double, n);
-            for (int i = 0; i < n; i++) {
-                GtkWidget *coef_entry = grid_at(gridRestrictions, 0 + 3*i, r);
-                info.coef_rest[r][i] = entry_to_double(coef_entry);
-            }
-            
-            GtkWidget *rhs_entry = grid_at(gridRestrictions, 3*n, r);
-            info.lados_derechos[r] = entry_to_double(rhs_entry);
-        }
-
-        if (resultado && resultado->tipo_solucion == SOLUCION_MULTIPLE) {
-            calcular_soluciones_adicionales(resultado, &info);
-        }
-        
-        
-        char nombre_archivo_tex[256];
-        char nombre_archivo_pdf[256];
-        const char *nombre_ingresado = gtk_entry_get_text(GTK_ENTRY(nameEntry));
-
-        if (nombre_ingresado && strlen(nombre_ingresado) > 0) {
-            char nombre_limpio[200];
-            int j = 0;
-            for (int i = 0; nombre_ingresado[i] != '\0' && j < 195; i++) {
-                if (isalnum(nombre_ingresado[i]) || nombre_ingresado[i] == '_' || nombre_ingresado[i] == '-') {
-                    nombre_limpio[j++] = nombre_ingresado[i];
-                } else if (nombre_ingresado[i] == ' ') {
-                    nombre_limpio[j++] = '_';
-                }
-            }
-            nombre_limpio[j] = '\0';
-            if (strlen(nombre_limpio) == 0) {
-                snprintf(nombre_limpio, sizeof(nombre_limpio), "simplex_resultado");
-            }
-            snprintf(nombre_archivo_tex, sizeof(nombre_archivo_tex), "%s.tex", nombre_limpio);
-            snprintf(nombre_archivo_pdf, sizeof(nombre_archivo_pdf), "%s.pdf", nombre_limpio);
-            
-            g_print("Guardando archivos con nombre personalizado: %s\n", nombre_limpio);
-        } else {
-            snprintf(nombre_archivo_tex, sizeof(nombre_archivo_tex), "simplex_resultado.tex");
-            snprintf(nombre_archivo_pdf, sizeof(nombre_archivo_pdf), "simplex_resultado.pdf");
-            
-            g_print("Guardando archivos con nombre por defecto\n");
-        }
-        generar_documento_latex(resultado, &info, nombre_archivo_tex, showTables);
-        compilar_y_mostrar_pdf(nombre_archivo_tex, nombre_archivo_pdf);
-        
-        g_free(info.tipos_restricciones); 
-        g_free(nombres_vars);
-        g_free(info.coef_obj);
-        for (int r = 0; r < m; r++) {
-            g_free(info.coef_rest[r]);
-        }
-        g_free(info.coef_rest);
-        g_free(info.lados_derechos);
+        g_print("Guardando archivos con nombre personalizado: %s\n", nombre_limpio);
+    } else {
+        snprintf(nombre_archivo_tex, sizeof(nombre_archivo_tex), "simplex_resultado.tex");
+        snprintf(nombre_archivo_pdf, sizeof(nombre_archivo_pdf), "simplex_resultado.pdf");
+        snprintf(nombre_archivo_reporte, sizeof(nombre_archivo_reporte), "simplex_resultado.%s", extension_reporte(formato));
         
-        liberar_resultado(resultado);
+        g_print("Guardando archivos con nombre por defecto\n");
+    }
+    
+    // Si el problema no cambió desde la última vez, se reutiliza el PDF ya compilado.
+    // Los demás formatos se generan en milisegundos y no pasan por la caché.
+    // Los límites del reporte también cambian el PDF, así que forman parte de la clave
+    gchar *hash = modelo_hash(modelo, showTables);
+    gchar *clave = g_strdup_printf("%s-k%d-c%d", hash, opciones.iteraciones_completas, opciones.max_columnas);
+    g_free(hash);
+    gchar *ruta_pdf = ruta_reporte(nombre_archivo_pdf);
+    if (formato == REPORTE_PDF && cache_reporte_restaurar(clave, ruta_pdf)) {
+        g_print("Problema sin cambios: se reutiliza el reporte %s\n", clave);
+        abrir_pdf(ruta_pdf);
+        g_free(ruta_pdf);
+        g_free(clave);
+        modelo_liberar(modelo);
+        return;
     }
+    g_free(ruta_pdf);
+    
+    TrabajoSimplex *trabajo = g_new0(TrabajoSimplex, 1);
+    trabajo->modelo = modelo;
+    trabajo->mostrar_tablas = showTables;
+    trabajo->opciones = opciones;
+    trabajo->formato = formato;
+    trabajo->ruta_salida = ruta_reporte(formato == REPORTE_PDF ? nombre_archivo_tex : nombre_archivo_reporte);
+    trabajo->clave = clave;
+    trabajo_actual = trabajo;
+    
+    contexto_simplex_reanudar(contexto_gui);
+    
+    gtk_widget_set_sensitive(solveButton, FALSE);
+    gtk_widget_set_sensitive(cancelButton, TRUE);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progressBar), "Resolviendo...");
+    gtk_widget_show(progressBar);
+    gtk_widget_show(cancelButton);
+    
+    g_thread_unref(g_thread_new("simplex", hilo_resolver, trabajo));
 }
 
 void on_saveButton_clicked(GtkWidget *widget, gpointer data) {
@@ -924,7 +1039,11 @@ void on_saveButton_clicked(GtkWidget *widget, gpointer data) {
         if (g_str_has_suffix(filename, ".csv")) with_ext = g_strdup(filename);
         else with_ext = g_strdup_printf("%s.csv", filename);
 
-        if (!setCSVPath(with_ext)) {
+        Modelo *modelo = leer_modelo_desde_interfaz();
+        gboolean ok = setCSVPath(with_ext, modelo);
+        if (modelo) modelo_liberar(modelo);
+
+        if (!ok) {
             GtkWidget *err = gtk_message_dialog_new(GTK_WINDOW(window), GTK_DIALOG_MODAL,
                                                     GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
                                                     "No se pudo guardar el archivo CSV.");
@@ -951,24 +1070,29 @@ void on_loadButton_clicked(GtkWidget *widget, gpointer data) {
     if (!filename) {
         GtkWidget *warn = gtk_message_dialog_new(GTK_WINDOW(window), GTK_DIALOG_MODAL,
                                                  GTK_MESSAGE_WARNING, GTK_BUTTONS_OK,
-                                                 "Seleccione un archivo CSV primero.");
+                                                 "Seleccione un archivo (CSV, MPS, LP o SPXM) primero.");
         gtk_dialog_run(GTK_DIALOG(warn));
         gtk_widget_destroy(warn);
         return;
     }
 
-    gboolean ok = loadFromCSV(filename);
+    // La lectura no toca widgets; la interfaz solo muestra el modelo resultante
+    Modelo *modelo = modelo_cargar_archivo(filename, FALSE);
     g_free(filename);
 
-    if (!ok) {
+    if (!modelo) {
         GtkWidget *err = gtk_message_dialog_new(GTK_WINDOW(window), GTK_DIALOG_MODAL,
                                                 GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
-                                                "No se pudo cargar el archivo CSV.");
+                                                "No se pudo cargar el archivo.");
         gtk_dialog_run(GTK_DIALOG(err));
         gtk_widget_destroy(err);
+        modelo_liberar(modelo);
         return;
     }
 
+    mostrar_modelo(modelo);
+    modelo_liberar(modelo);
+
     gtk_widget_set_sensitive(solveButton, TRUE);
 }
 
@@ -1027,11 +1151,18 @@ int main (int argc, char *argv[]){
     loadFileButton = GTK_WIDGET(gtk_builder_get_object(builder, "loadFileButton"));
     cargarLabel = GTK_WIDGET(gtk_builder_get_object(builder, "cargarLabel"));
     showTablesCheck = GTK_WIDGET(gtk_builder_get_object(builder, "showTablesCheck"));
+    formatCombo = GTK_WIDGET(gtk_builder_get_object(builder, "formatCombo"));
+    fullIterationsLabel = GTK_WIDGET(gtk_builder_get_object(builder, "fullIterationsLabel"));
+    spinFullIterations = GTK_WIDGET(gtk_builder_get_object(builder, "spinFullIterations"));
+    maxColumnsLabel = GTK_WIDGET(gtk_builder_get_object(builder, "maxColumnsLabel"));
+    spinMaxColumns = GTK_WIDGET(gtk_builder_get_object(builder, "spinMaxColumns"));
     solveButton = GTK_WIDGET(gtk_builder_get_object(builder, "solveButton"));
     exitButton = GTK_WIDGET(gtk_builder_get_object(builder, "exitButton"));
     dantzigImage = GTK_WIDGET(gtk_builder_get_object(builder, "dantzigImage"));
     saveButton = GTK_WIDGET(gtk_builder_get_object(builder, "saveButton"));
     loadButton = GTK_WIDGET(gtk_builder_get_object(builder, "loadButton"));
+    progressBar = GTK_WIDGET(gtk_builder_get_object(builder, "progressBar"));
+    cancelButton = GTK_WIDGET(gtk_builder_get_object(builder, "cancelButton"));
 
     cssProvider = gtk_css_provider_new();
     gtk_css_provider_load_from_path(cssProvider, "theme.css", NULL);
@@ -1040,6 +1171,7 @@ int main (int argc, char *argv[]){
     set_css(cssProvider, continueButton);
     set_css(cssProvider, loadFileButton);
     set_css(cssProvider, solveButton);
+    set_css(cssProvider, cancelButton);
     set_css(cssProvider, exitButton);
 
     gtk_widget_set_sensitive(solveButton, FALSE);
@@ -1052,6 +1184,13 @@ int main (int argc, char *argv[]){
     g_signal_connect(exitButton, "clicked", G_CALLBACK(on_exitButton_clicked), NULL);
     g_signal_connect(saveButton, "clicked", G_CALLBACK(on_saveButton_clicked), NULL);
     g_signal_connect(loadButton, "clicked", G_CALLBACK(on_loadButton_clicked), NULL);
+    g_signal_connect(cancelButton, "clicked", G_CALLBACK(on_cancelButton_clicked), NULL);
+
+    contexto_gui = contexto_simplex_nuevo();
+    contexto_simplex_establecer_progreso(contexto_gui, progreso_resolucion, NULL);
+
+    entradas_variables = g_ptr_array_new();
+    terminos_z = g_array_new(FALSE, FALSE, sizeof(TerminoZ));
 
     gridVariables = gtk_grid_new();
     gtk_grid_set_row_spacing(GTK_GRID(gridVariables), 6);
@@ -1061,13 +1200,13 @@ int main (int argc, char *argv[]){
     gtk_grid_set_column_spacing(GTK_GRID(ZGrid), 8);
     gtk_grid_set_row_spacing(GTK_GRID(ZGrid), 6);
     gtk_container_add(GTK_CONTAINER(ZScroll), ZGrid);
+    gtk_widget_show(ZGrid);
 
-    gridRestrictions = gtk_grid_new();
-    gtk_grid_set_column_spacing(GTK_GRID(gridRestrictions), 8);
-    gtk_grid_set_row_spacing(GTK_GRID(gridRestrictions), 6);
-    gtk_container_add(GTK_CONTAINER(restrictionsScroll), gridRestrictions);
+    crear_tabla_restricciones();
+    gtk_container_add(GTK_CONTAINER(restrictionsScroll), treeRestrictions);
 
     gtk_container_add(GTK_CONTAINER(variablesScroll), gridVariables);
+    gtk_widget_show(gridVariables);
         
     g_signal_connect(spinVariables, "value-changed",G_CALLBACK(createVariables), NULL);
     
@@ -0,0 +1,188 @@
+#include "modelo.h"
+#include "csv.h"
+#include "mps.h"
+#include "lp.h"
+#include "binario.h"
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Crea un modelo con todos los coeficientes en cero, restricciones <= y nombres X1..Xn
+Modelo* modelo_nuevo(const char *nombre, TipoProblema tipo, int num_vars, int num_rest) {
+    Arena *arena = arena_nueva(0);
+    Modelo *modelo = arena_new0(arena, Modelo, 1);
+    modelo->arena = arena;
+    modelo->nombre = arena_strdup(arena, (nombre && *nombre) ? nombre : "Problema de Optimización");
+    modelo->tipo = tipo;
+    modelo->num_vars = num_vars;
+    modelo->num_rest = num_rest;
+
+    modelo->nombres_vars = arena_new0(arena, char*, num_vars);
+    for (int i = 0; i < num_vars; i++) {
+        modelo->nombres_vars[i] = arena_strdup_printf(arena, "X%d", i + 1);
+    }
+
+    modelo->c = arena_new0(arena, double, num_vars);
+    modelo->A = arena_new0(arena, double*, num_rest);
+    for (int r = 0; r < num_rest; r++) {
+        modelo->A[r] = arena_new0(arena, double, num_vars);
+    }
+    modelo->lados_derechos = arena_new0(arena, double, num_rest);
+    modelo->tipos_restricciones = arena_new0(arena, TipoRestriccion, num_rest);
+
+    return modelo;
+}
+
+void modelo_liberar(Modelo *modelo) {
+    if (!modelo) return;
+    arena_liberar(modelo->arena);
+}
+
+void modelo_establecer_nombre_variable(Modelo *modelo, int indice, const char *nombre) {
+    if (indice < 0 || indice >= modelo->num_vars || !nombre) return;
+    modelo->nombres_vars[indice] = arena_strdup(modelo->arena, nombre);
+}
+
+// Índice de la primera variable que admite valores negativos, o -1 si no hay
+int modelo_cota_negativa(const CotaVariable *cotas, int num_vars) {
+    for (int j = 0; j < num_vars; j++) {
+        if (cotas[j].inferior < 0) return j;
+    }
+    return -1;
+}
+
+// Cantidad de restricciones que agrega modelo_agregar_cotas
+int modelo_filas_de_cotas(const CotaVariable *cotas, int num_vars) {
+    int filas = 0;
+    for (int j = 0; j < num_vars; j++) {
+        if (cotas[j].inferior == cotas[j].superior) {
+            filas++;
+        } else {
+            if (cotas[j].inferior > 0) filas++;
+            if (isfinite(cotas[j].superior)) filas++;
+        }
+    }
+    return filas;
+}
+
+// Escribe las cotas como restricciones x_j >= l, x_j <= u o x_j = v desde 'primera_fila'
+void modelo_agregar_cotas(Modelo *modelo, int primera_fila, const CotaVariable *cotas) {
+    int r = primera_fila;
+    for (int j = 0; j < modelo->num_vars; j++) {
+        if (cotas[j].inferior == cotas[j].superior) {
+            modelo->A[r][j] = 1.0;
+            modelo->tipos_restricciones[r] = RESTRICCION_EQ;
+            modelo->lados_derechos[r++] = cotas[j].inferior;
+            continue;
+        }
+        if (cotas[j].inferior > 0) {
+            modelo->A[r][j] = 1.0;
+            modelo->tipos_restricciones[r] = RESTRICCION_GE;
+            modelo->lados_derechos[r++] = cotas[j].inferior;
+        }
+        if (isfinite(cotas[j].superior)) {
+            modelo->A[r][j] = 1.0;
+            modelo->tipos_restricciones[r] = RESTRICCION_LE;
+            modelo->lados_derechos[r++] = cotas[j].superior;
+        }
+    }
+}
+
+// La tabla inicial necesita b >= 0: las filas con lado derecho negativo se multiplican por -1
+void modelo_normalizar_lados_derechos(Modelo *modelo) {
+    for (int r = 0; r < modelo->num_rest; r++) {
+        if (modelo->lados_derechos[r] >= 0) continue;
+        for (int j = 0; j < modelo->num_vars; j++) {
+            if (modelo->A[r][j] != 0.0) modelo->A[r][j] = -modelo->A[r][j];
+        }
+        modelo->lados_derechos[r] = -modelo->lados_derechos[r];
+        if (modelo->tipos_restricciones[r] == RESTRICCION_LE) {
+            modelo->tipos_restricciones[r] = RESTRICCION_GE;
+        } else if (modelo->tipos_restricciones[r] == RESTRICCION_GE) {
+            modelo->tipos_restricciones[r] = RESTRICCION_LE;
+        }
+    }
+}
+
+// Construye la tabla simplex del modelo (el llamador la libera con liberar_tabla_simplex)
+TablaSimplex* modelo_a_tabla(const Modelo *modelo) {
+    TablaSimplex *tabla = crear_tabla_simplex(modelo->num_vars, modelo->num_rest, modelo->tipo);
+    establecer_funcion_objetivo(tabla, modelo->c);
+    for (int r = 0; r < modelo->num_rest; r++) {
+        agregar_restriccion(tabla, r, modelo->A[r], modelo->lados_derechos[r],
+                            modelo->tipos_restricciones[r]);
+    }
+    return tabla;
+}
+
+// Llena la información para el reporte; los arreglos se comparten con el modelo
+void modelo_a_info(const Modelo *modelo, ProblemaInfo *info) {
+    info->nombre_problema = modelo->nombre;
+    info->tipo_problema = (modelo->tipo == MAXIMIZACION) ? "MAX" : "MIN";
+    info->num_vars = modelo->num_vars;
+    info->num_rest = modelo->num_rest;
+    info->nombres_vars = (const char**)modelo->nombres_vars;
+    info->coef_obj = modelo->c;
+    info->coef_rest = modelo->A;
+    info->lados_derechos = modelo->lados_derechos;
+    info->tipos_restricciones = modelo->tipos_restricciones;
+}
+
+static void hash_entero(GChecksum *suma, gint32 valor) {
+    guint32 le = GUINT32_TO_LE((guint32)valor);
+    g_checksum_update(suma, (const guchar*)&le, sizeof(le));
+}
+
+static void hash_double(GChecksum *suma, double valor) {
+    if (valor == 0.0) valor = 0.0;  // -0.0 y 0.0 dan el mismo reporte
+    guint64 bits;
+    memcpy(&bits, &valor, sizeof(bits));
+    bits = GUINT64_TO_LE(bits);
+    g_checksum_update(suma, (const guchar*)&bits, sizeof(bits));
+}
+
+static void hash_texto(GChecksum *suma, const char *texto) {
+    gsize largo = texto ? strlen(texto) : 0;
+    hash_entero(suma, (gint32)largo);
+    g_checksum_update(suma, (const guchar*)(texto ? texto : ""), (gssize)largo);
+}
+
+// SHA-256 de la forma canónica del modelo (todo lo que cambia el reporte).
+// El resultado se libera con g_free.
+gchar* modelo_hash(const Modelo *modelo, gboolean mostrar_tablas) {
+    GChecksum *suma = g_checksum_new(G_CHECKSUM_SHA256);
+    
+    hash_texto(suma, "simplex-modelo-v1");
+    hash_texto(suma, modelo->nombre);
+    hash_entero(suma, modelo->tipo);
+    hash_entero(suma, modelo->num_vars);
+    hash_entero(suma, modelo->num_rest);
+    hash_entero(suma, mostrar_tablas ? 1 : 0);
+    
+    for (int i = 0; i < modelo->num_vars; i++) {
+        hash_texto(suma, modelo->nombres_vars[i]);
+        hash_double(suma, modelo->c[i]);
+    }
+    for (int r = 0; r < modelo->num_rest; r++) {
+        for (int i = 0; i < modelo->num_vars; i++) {
+            hash_double(suma, modelo->A[r][i]);
+        }
+        hash_entero(suma, modelo->tipos_restricciones[r]);
+        hash_double(suma, modelo->lados_derechos[r]);
+    }
+    
+    gchar *hash = g_strdup(g_checksum_get_string(suma));
+    g_checksum_free(suma);
+    return hash;
+}
+
+// Carga un problema eligiendo el lector por la extensión (.mps, .lp, .spxm; cualquier otra
+// se lee como el CSV de la interfaz). Los MPS se leen en formato libre salvo que se
+// pida el fijo. Devuelve NULL si el archivo no se pudo leer.
+Modelo* modelo_cargar_archivo(const char *ruta, gboolean mps_fijo) {
+    const char *punto = ruta ? strrchr(ruta, '.') : NULL;
+    if (punto && g_ascii_strcasecmp(punto, ".mps") == 0) return modelo_cargar_mps(ruta, mps_fijo);
+    if (punto && g_ascii_strcasecmp(punto, ".lp") == 0) return modelo_cargar_lp(ruta);
+    if (punto && g_ascii_strcasecmp(punto, ".spxm") == 0) return modelo_cargar_binario(ruta);
+    return modelo_cargar_csv(ruta);
+}
@@ -0,0 +1,46 @@
+#ifndef MODELO_H
+#define MODELO_H
+
+#include <glib.h>
+#include "simplex.h"
+
+G_BEGIN_DECLS
+
+// Copia inmutable de un problema de programación lineal (independiente de la interfaz)
+typedef struct {
+    char *nombre;
+    TipoProblema tipo;
+    int num_vars;
+    int num_rest;
+    char **nombres_vars;
+    double *c;
+    double **A;
+    double *lados_derechos;
+    TipoRestriccion *tipos_restricciones;
+
+    Arena *arena;   // Dueña de todos los arreglos del modelo
+} Modelo;
+
+// Cotas de una variable leídas de un archivo MPS o LP. Como el método supone x >= 0,
+// se agregan al modelo como restricciones sobre una sola variable.
+typedef struct {
+    double inferior;    // 0 por defecto
+    double superior;    // INFINITY si no tiene
+} CotaVariable;
+
+// Prototipos de funciones
+Modelo* modelo_nuevo(const char *nombre, TipoProblema tipo, int num_vars, int num_rest);
+void modelo_liberar(Modelo *modelo);
+void modelo_establecer_nombre_variable(Modelo *modelo, int indice, const char *nombre);
+TablaSimplex* modelo_a_tabla(const Modelo *modelo);
+void modelo_a_info(const Modelo *modelo, ProblemaInfo *info);
+gchar* modelo_hash(const Modelo *modelo, gboolean mostrar_tablas);
+Modelo* modelo_cargar_archivo(const char *ruta, gboolean mps_fijo);
+int modelo_cota_negativa(const CotaVariable *cotas, int num_vars);
+int modelo_filas_de_cotas(const CotaVariable *cotas, int num_vars);
+void modelo_agregar_cotas(Modelo *modelo, int primera_fila, const CotaVariable *cotas);
+void modelo_normalizar_lados_derechos(Modelo *modelo);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,599 @@
+#include "mps.h"
+#include "formato.h"
+#include "salida.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+
+typedef enum {
+    SECCION_NINGUNA,
+    SECCION_OBJSENSE,
+    SECCION_ROWS,
+    SECCION_COLUMNS,
+    SECCION_RHS,
+    SECCION_RANGES,
+    SECCION_BOUNDS,
+    SECCION_FIN
+} SeccionMps;
+
+typedef struct {
+    int fila;
+    int columna;
+    double valor;
+} CoeficienteMps;
+
+// Campos de una línea de datos; en formato fijo son a lo sumo seis
+#define MPS_MAX_CAMPOS 8
+
+// Estado de la lectura: todo se acumula en una sola pasada y el modelo denso se arma al final
+typedef struct {
+    const char *ruta;
+    gboolean fijo;
+    int num_linea;
+    gboolean error;
+    SeccionMps seccion;
+    gchar *nombre;
+    TipoProblema tipo;
+
+    GStringChunk *nombres;          // Cada nombre se guarda una sola vez
+    GHashTable *indice_filas;       // Nombre internado -> índice + 1
+    GHashTable *indice_columnas;
+    GArray *tipos_filas;            // char: 'N', 'L', 'G' o 'E'
+    GArray *lados_derechos;         // double por fila
+    GArray *rangos;                 // double por fila (NAN si no tiene)
+    GPtrArray *nombres_columnas;
+    GArray *cotas;                  // CotaVariable por columna
+    GArray *coeficientes;           // CoeficienteMps en el orden del archivo
+    int fila_objetivo;              // Primera fila N (-1 si todavía no hay)
+
+    // Solo se usa el primer conjunto de cada sección, como hacen los demás lectores
+    const char *conjunto_rhs;
+    const char *conjunto_rangos;
+    const char *conjunto_cotas;
+} LectorMps;
+
+static void error_mps(LectorMps *lector, const char *formato, ...) G_GNUC_PRINTF(2, 3);
+
+static void error_mps(LectorMps *lector, const char *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    gchar *mensaje = g_strdup_vprintf(formato, args);
+    va_end(args);
+
+    // Los errores al armar el modelo no corresponden a una línea
+    if (!lector->error && lector->num_linea > 0) {
+        g_printerr("%s:%d: %s\n", lector->ruta, lector->num_linea, mensaje);
+    } else if (!lector->error) {
+        g_printerr("%s: %s\n", lector->ruta, mensaje);
+    }
+    lector->error = TRUE;
+    g_free(mensaje);
+}
+
+static int buscar_indice(GHashTable *indice, const char *nombre) {
+    return GPOINTER_TO_INT(g_hash_table_lookup(indice, nombre)) - 1;
+}
+
+static gboolean leer_numero(LectorMps *lector, const char *texto, double *valor) {
+    char *fin;
+    *valor = g_ascii_strtod(texto, &fin);
+    if (fin == texto || *fin != '\0') {
+        error_mps(lector, "número no válido: '%s'", texto);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+// ---------------- Separación de campos ----------------
+
+// Formato libre: campos separados por espacios (se cortan en el mismo búfer)
+static int separar_libre(char *linea, char **campos) {
+    int n = 0;
+    char *p = linea;
+    while (*p && n < MPS_MAX_CAMPOS) {
+        while (*p == ' ' || *p == '\t') p++;
+        if (!*p) break;
+        campos[n++] = p;
+        while (*p && *p != ' ' && *p != '\t') p++;
+        if (*p) *p++ = '\0';
+    }
+    return n;
+}
+
+// Formato fijo: columnas 2-3, 5-12, 15-22, 25-36, 40-47 y 50-61. Los nombres pueden
+// tener espacios; los campos vacíos se descartan, así que el resultado se interpreta
+// igual que el del formato libre.
+static int separar_fijo(const char *linea, char copia[][16], char **campos) {
+    static const int inicio[] = { 1, 4, 14, 24, 39, 49 };
+    static const int fin[]    = { 3, 12, 22, 36, 47, 61 };
+    int largo = (int)strlen(linea);
+    int n = 0;
+
+    for (int k = 0; k < 6; k++) {
+        if (inicio[k] >= largo) break;
+        int hasta = MIN(fin[k], largo);
+        int tam = hasta - inicio[k];
+        memcpy(copia[k], linea + inicio[k], tam);
+        copia[k][tam] = '\0';
+        g_strstrip(copia[k]);
+        if (copia[k][0]) campos[n++] = copia[k];
+    }
+    return n;
+}
+
+// ---------------- Secciones ----------------
+
+static void leer_encabezado(LectorMps *lector, char *linea) {
+    char *campos[MPS_MAX_CAMPOS];
+    char *resto = linea;
+    while (*resto && *resto != ' ' && *resto != '\t') resto++;
+    gchar *valor = g_strstrip(g_strdup(resto));
+    int n = separar_libre(linea, campos);
+    const char *seccion = n > 0 ? campos[0] : "";
+
+    if (g_ascii_strcasecmp(seccion, "NAME") == 0) {
+        g_free(lector->nombre);
+        lector->nombre = g_strdup(valor);
+        lector->seccion = SECCION_NINGUNA;
+    } else if (g_ascii_strcasecmp(seccion, "OBJSENSE") == 0) {
+        lector->seccion = SECCION_OBJSENSE;
+        if (*valor) {
+            lector->tipo = g_ascii_strncasecmp(valor, "MAX", 3) == 0 ? MAXIMIZACION : MINIMIZACION;
+        }
+    } else if (g_ascii_strcasecmp(seccion, "ROWS") == 0) {
+        lector->seccion = SECCION_ROWS;
+    } else if (g_ascii_strcasecmp(seccion, "COLUMNS") == 0) {
+        lector->seccion = SECCION_COLUMNS;
+    } else if (g_ascii_strcasecmp(seccion, "RHS") == 0) {
+        lector->seccion = SECCION_RHS;
+    } else if (g_ascii_strcasecmp(seccion, "RANGES") == 0) {
+        lector->seccion = SECCION_RANGES;
+    } else if (g_ascii_strcasecmp(seccion, "BOUNDS") == 0) {
+        lector->seccion = SECCION_BOUNDS;
+    } else if (g_ascii_strcasecmp(seccion, "ENDATA") == 0) {
+        lector->seccion = SECCION_FIN;
+    } else {
+        error_mps(lector, "sección no soportada: %s", seccion);
+    }
+    g_free(valor);
+}
+
+static void leer_fila(LectorMps *lector, char **campos, int n) {
+    if (n < 2 || strlen(campos[0]) != 1 || !strchr("NLGEnlge", campos[0][0])) {
+        error_mps(lector, "se esperaba 'tipo nombre' en ROWS");
+        return;
+    }
+    const char *nombre = g_string_chunk_insert_const(lector->nombres, campos[1]);
+    if (g_hash_table_contains(lector->indice_filas, nombre)) {
+        error_mps(lector, "fila repetida: %s", nombre);
+        return;
+    }
+
+    char tipo = g_ascii_toupper(campos[0][0]);
+    double cero = 0.0, sin_rango = NAN;
+    int indice = (int)lector->tipos_filas->len;
+    g_array_append_val(lector->tipos_filas, tipo);
+    g_array_append_val(lector->lados_derechos, cero);
+    g_array_append_val(lector->rangos, sin_rango);
+    g_hash_table_insert(lector->indice_filas, (gpointer)nombre, GINT_TO_POINTER(indice + 1));
+
+    if (tipo == 'N' && lector->fila_objetivo < 0) {
+        lector->fila_objetivo = indice;
+    }
+}
+
+static int buscar_fila(LectorMps *lector, const char *nombre) {
+    int fila = buscar_indice(lector->indice_filas, nombre);
+    if (fila < 0) error_mps(lector, "fila desconocida: %s", nombre);
+    return fila;
+}
+
+static void leer_columna(LectorMps *lector, char **campos, int n) {
+    // Marcadores de variables enteras: la integralidad no se usa
+    if (n >= 2 && strcmp(campos[1], "'MARKER'") == 0) return;
+    if (n < 3 || n % 2 == 0) {
+        error_mps(lector, "se esperaba 'columna fila valor [fila valor]' en COLUMNS");
+        return;
+    }
+
+    const char *nombre = g_string_chunk_insert_const(lector->nombres, campos[0]);
+    int columna = buscar_indice(lector->indice_columnas, nombre);
+    if (columna < 0) {
+        CotaVariable cota = { 0.0, INFINITY };
+        columna = (int)lector->nombres_columnas->len;
+        g_ptr_array_add(lector->nombres_columnas, (gpointer)nombre);
+        g_array_append_val(lector->cotas, cota);
+        g_hash_table_insert(lector->indice_columnas, (gpointer)nombre, GINT_TO_POINTER(columna + 1));
+    }
+
+    for (int k = 1; k + 1 < n; k += 2) {
+        CoeficienteMps coef = { buscar_fila(lector, campos[k]), columna, 0.0 };
+        if (coef.fila < 0 || !leer_numero(lector, campos[k + 1], &coef.valor)) return;
+        if (g_array_index(lector->tipos_filas, char, coef.fila) == 'N' && coef.fila != lector->fila_objetivo) {
+            continue;   // Filas N adicionales: no forman parte del modelo
+        }
+        if (coef.valor != 0.0) {
+            g_array_append_val(lector->coeficientes, coef);
+        }
+    }
+}
+
+// RHS y RANGES: '[conjunto] fila valor [fila valor]'
+static void leer_valores_filas(LectorMps *lector, char **campos, int n, GArray *destino, const char **conjunto) {
+    int k = 0;
+    if (n % 2 == 1) {
+        const char *nombre = g_string_chunk_insert_const(lector->nombres, campos[0]);
+        if (!*conjunto) *conjunto = nombre;
+        if (*conjunto != nombre) return;
+        k = 1;
+    }
+    if (n - k < 2) {
+        error_mps(lector, "se esperaba '[conjunto] fila valor [fila valor]'");
+        return;
+    }
+
+    for (; k + 1 < n; k += 2) {
+        double valor;
+        int fila = buscar_fila(lector, campos[k]);
+        if (fila < 0 || !leer_numero(lector, campos[k + 1], &valor)) return;
+        // El RHS de la fila objetivo es una constante de Z, que el modelo no representa
+        if (fila == lector->fila_objetivo && destino == lector->lados_derechos && valor != 0.0) {
+            error_mps(lector, "el objetivo no puede tener un término constante (RHS de %s)", campos[k]);
+            return;
+        }
+        if (g_array_index(lector->tipos_filas, char, fila) == 'N') continue;
+        g_array_index(destino, double, fila) = valor;
+    }
+}
+
+static gboolean es_numero(const char *texto) {
+    char *fin;
+    g_ascii_strtod(texto, &fin);
+    return fin != texto && *fin == '\0';
+}
+
+// BOUNDS: 'tipo [conjunto] columna [valor]'. UP, LO, FX, UI y LI llevan valor;
+// en MI, PL, FR y BV es opcional y se ignora. El conjunto se reconoce por la cantidad
+// de campos; con tres campos y valor opcional, 'columna valor' se prefiere a 'conjunto columna'.
+static void leer_cota(LectorMps *lector, char **campos, int n) {
+    if (n < 2 || n > 4) {
+        error_mps(lector, "se esperaba 'tipo [conjunto] columna [valor]' en BOUNDS");
+        return;
+    }
+
+    const char *tipo = campos[0];
+    gboolean lleva_valor = g_ascii_strcasecmp(tipo, "UP") == 0 || g_ascii_strcasecmp(tipo, "LO") == 0 ||
+                           g_ascii_strcasecmp(tipo, "FX") == 0 || g_ascii_strcasecmp(tipo, "UI") == 0 ||
+                           g_ascii_strcasecmp(tipo, "LI") == 0;
+    gboolean con_conjunto;
+    if (lleva_valor) {
+        if (n < 3) {
+            error_mps(lector, "falta el valor de la cota %s", tipo);
+            return;
+        }
+        con_conjunto = n == 4;
+    } else {
+        con_conjunto = n == 4 ||
+                       (n == 3 && !(buscar_indice(lector->indice_columnas, campos[1]) >= 0 && es_numero(campos[2])));
+    }
+
+    int k = 1;
+    if (con_conjunto) {
+        const char *nombre = g_string_chunk_insert_const(lector->nombres, campos[1]);
+        if (!lector->conjunto_cotas) lector->conjunto_cotas = nombre;
+        if (lector->conjunto_cotas != nombre) return;
+        k = 2;
+    }
+
+    int columna = buscar_indice(lector->indice_columnas, campos[k]);
+    if (columna < 0) {
+        error_mps(lector, "columna desconocida: %s", campos[k]);
+        return;
+    }
+    double valor = 0.0;
+    if (lleva_valor && !leer_numero(lector, campos[k + 1], &valor)) return;
+
+    CotaVariable *cota = &g_array_index(lector->cotas, CotaVariable, columna);
+    if (g_ascii_strcasecmp(tipo, "UP") == 0 || g_ascii_strcasecmp(tipo, "UI") == 0) {
+        // Convención habitual: una cota superior negativa sin inferior deja la variable libre por abajo
+        if (valor < 0 && cota->inferior == 0.0) cota->inferior = -INFINITY;
+        cota->superior = valor;
+    } else if (g_ascii_strcasecmp(tipo, "LO") == 0 || g_ascii_strcasecmp(tipo, "LI") == 0) {
+        cota->inferior = valor;
+    } else if (g_ascii_strcasecmp(tipo, "FX") == 0) {
+        cota->inferior = cota->superior = valor;
+    } else if (g_ascii_strcasecmp(tipo, "MI") == 0) {
+        cota->inferior = -INFINITY;
+    } else if (g_ascii_strcasecmp(tipo, "PL") == 0) {
+        cota->superior = INFINITY;
+    } else if (g_ascii_strcasecmp(tipo, "FR") == 0) {
+        cota->inferior = -INFINITY;
+        cota->superior = INFINITY;
+    } else if (g_ascii_strcasecmp(tipo, "BV") == 0) {
+        cota->inferior = 0.0;
+        cota->superior = 1.0;
+    } else {
+        error_mps(lector, "tipo de cota no soportado: %s", tipo);
+    }
+}
+
+static void leer_linea(LectorMps *lector, char *linea) {
+    // Comentarios y líneas vacías
+    if (linea[0] == '*' || linea[strspn(linea, " \t")] == '\0') return;
+
+    if (linea[0] != ' ' && linea[0] != '\t') {
+        leer_encabezado(lector, linea);
+        return;
+    }
+
+    char *campos[MPS_MAX_CAMPOS];
+    char copia[6][16];
+    int n = lector->fijo ? separar_fijo(linea, copia, campos) : separar_libre(linea, campos);
+    if (n == 0) {
+        error_mps(lector, "línea sin campos en las columnas del formato fijo");
+        return;
+    }
+
+    switch (lector->seccion) {
+        case SECCION_OBJSENSE:
+            lector->tipo = g_ascii_strncasecmp(campos[0], "MAX", 3) == 0 ? MAXIMIZACION : MINIMIZACION;
+            break;
+        case SECCION_ROWS:
+            leer_fila(lector, campos, n);
+            break;
+        case SECCION_COLUMNS:
+            leer_columna(lector, campos, n);
+            break;
+        case SECCION_RHS:
+            leer_valores_filas(lector, campos, n, lector->lados_derechos, &lector->conjunto_rhs);
+            break;
+        case SECCION_RANGES:
+            leer_valores_filas(lector, campos, n, lector->rangos, &lector->conjunto_rangos);
+            break;
+        case SECCION_BOUNDS:
+            leer_cota(lector, campos, n);
+            break;
+        default:
+            error_mps(lector, "datos fuera de una sección");
+            break;
+    }
+}
+
+// ---------------- Construcción del modelo ----------------
+
+static void fijar_restriccion(Modelo *modelo, int r, TipoRestriccion tipo, double lado_derecho) {
+    modelo->tipos_restricciones[r] = tipo;
+    modelo->lados_derechos[r] = lado_derecho;
+}
+
+static Modelo* construir_modelo(LectorMps *lector) {
+    int num_filas = (int)lector->tipos_filas->len;
+    int n = (int)lector->nombres_columnas->len;
+    lector->num_linea = 0;
+    if (n == 0) {
+        error_mps(lector, "el modelo no tiene columnas");
+        return NULL;
+    }
+
+    // Índice de la primera (y, si hay rango, la segunda) restricción de cada fila
+    int *primera = g_new(int, num_filas);
+    int *segunda = g_new(int, num_filas);
+    int m = 0;
+    for (int f = 0; f < num_filas; f++) {
+        char tipo = g_array_index(lector->tipos_filas, char, f);
+        double rango = g_array_index(lector->rangos, double, f);
+        primera[f] = segunda[f] = -1;
+        if (tipo == 'N') continue;
+        primera[f] = m++;
+        if (!isnan(rango) && !(tipo == 'E' && rango == 0.0)) {
+            segunda[f] = m++;
+        }
+    }
+
+    // Las cotas se convierten en restricciones sobre una sola variable
+    const CotaVariable *cotas = (const CotaVariable*)lector->cotas->data;
+    int negativa = modelo_cota_negativa(cotas, n);
+    if (negativa >= 0) {
+        error_mps(lector, "la variable %s admite valores negativos; el método supone x >= 0",
+                  (const char*)g_ptr_array_index(lector->nombres_columnas, negativa));
+        g_free(primera);
+        g_free(segunda);
+        return NULL;
+    }
+    int m_filas = m;
+    m += modelo_filas_de_cotas(cotas, n);
+
+    Modelo *modelo = modelo_nuevo(lector->nombre, lector->tipo, n, m);
+    for (int j = 0; j < n; j++) {
+        modelo_establecer_nombre_variable(modelo, j, g_ptr_array_index(lector->nombres_columnas, j));
+    }
+
+    for (guint k = 0; k < lector->coeficientes->len; k++) {
+        CoeficienteMps *coef = &g_array_index(lector->coeficientes, CoeficienteMps, k);
+        if (coef->fila == lector->fila_objetivo) {
+            modelo->c[coef->columna] += coef->valor;
+            continue;
+        }
+        modelo->A[primera[coef->fila]][coef->columna] += coef->valor;
+        if (segunda[coef->fila] >= 0) {
+            modelo->A[segunda[coef->fila]][coef->columna] += coef->valor;
+        }
+    }
+
+    // Filas con RANGES: L -> [b - |R|, b], G -> [b, b + |R|], E -> entre b y b + R
+    for (int f = 0; f < num_filas; f++) {
+        if (primera[f] < 0) continue;
+        char tipo = g_array_index(lector->tipos_filas, char, f);
+        double b = g_array_index(lector->lados_derechos, double, f);
+        double rango = g_array_index(lector->rangos, double, f);
+
+        if (segunda[f] < 0) {
+            fijar_restriccion(modelo, primera[f],
+                              tipo == 'L' ? RESTRICCION_LE : tipo == 'G' ? RESTRICCION_GE : RESTRICCION_EQ, b);
+            continue;
+        }
+
+        double inferior, superior;
+        if (tipo == 'L') {
+            inferior = b - fabs(rango);
+            superior = b;
+        } else if (tipo == 'G') {
+            inferior = b;
+            superior = b + fabs(rango);
+        } else {
+            inferior = MIN(b, b + rango);
+            superior = MAX(b, b + rango);
+        }
+        fijar_restriccion(modelo, primera[f], RESTRICCION_GE, inferior);
+        fijar_restriccion(modelo, segunda[f], RESTRICCION_LE, superior);
+    }
+
+    modelo_agregar_cotas(modelo, m_filas, cotas);
+    modelo_normalizar_lados_derechos(modelo);
+
+    g_free(primera);
+    g_free(segunda);
+    return modelo;
+}
+
+// Lee un archivo MPS en una sola pasada, línea por línea. Devuelve NULL (y escribe
+// el motivo con g_printerr) si el archivo no existe, tiene errores o usa algo que
+// el método no puede representar.
+Modelo* modelo_cargar_mps(const char *ruta, gboolean formato_fijo) {
+    FILE *archivo = fopen(ruta, "r");
+    if (!archivo) {
+        g_printerr("Error: No se pudo abrir el archivo %s\n", ruta);
+        return NULL;
+    }
+
+    LectorMps lector = {
+        .ruta = ruta,
+        .fijo = formato_fijo,
+        .tipo = MINIMIZACION,
+        .fila_objetivo = -1,
+        .nombres = g_string_chunk_new(4096),
+        .indice_filas = g_hash_table_new(g_str_hash, g_str_equal),
+        .indice_columnas = g_hash_table_new(g_str_hash, g_str_equal),
+        .tipos_filas = g_array_new(FALSE, FALSE, sizeof(char)),
+        .lados_derechos = g_array_new(FALSE, FALSE, sizeof(double)),
+        .rangos = g_array_new(FALSE, FALSE, sizeof(double)),
+        .nombres_columnas = g_ptr_array_new(),
+        .cotas = g_array_new(FALSE, FALSE, sizeof(CotaVariable)),
+        .coeficientes = g_array_new(FALSE, FALSE, sizeof(CoeficienteMps)),
+    };
+
+    char *linea = NULL;
+    size_t capacidad = 0;
+    ssize_t largo;
+    while (!lector.error && lector.seccion != SECCION_FIN &&
+           (largo = getline(&linea, &capacidad, archivo)) >= 0) {
+        lector.num_linea++;
+        while (largo > 0 && (linea[largo - 1] == '\n' || linea[largo - 1] == '\r')) {
+            linea[--largo] = '\0';
+        }
+        leer_linea(&lector, linea);
+    }
+    free(linea);
+    fclose(archivo);
+
+    if (!lector.error && lector.seccion != SECCION_FIN) {
+        error_mps(&lector, "falta ENDATA");
+    }
+    Modelo *modelo = lector.error ? NULL : construir_modelo(&lector);
+
+    g_free(lector.nombre);
+    g_hash_table_destroy(lector.indice_filas);
+    g_hash_table_destroy(lector.indice_columnas);
+    g_array_free(lector.tipos_filas, TRUE);
+    g_array_free(lector.lados_derechos, TRUE);
+    g_array_free(lector.rangos, TRUE);
+    g_ptr_array_free(lector.nombres_columnas, TRUE);
+    g_array_free(lector.cotas, TRUE);
+    g_array_free(lector.coeficientes, TRUE);
+    g_string_chunk_free(lector.nombres);
+    return modelo;
+}
+
+// ---------------- Escritura ----------------
+
+// En MPS los nombres no pueden tener espacios
+static void escribir_nombre(Salida *salida, const char *nombre, int ancho) {
+    int largo = 0;
+    for (const char *p = nombre; *p; p++, largo++) {
+        salida_append_c(salida, (*p == ' ' || *p == '\t') ? '_' : *p);
+    }
+    for (; largo < ancho; largo++) {
+        salida_append_c(salida, ' ');
+    }
+}
+
+// Línea de COLUMNS o RHS. Con nombres de hasta 8 caracteres queda en las columnas
+// del formato fijo, así que el archivo sirve para ambos lectores.
+static void escribir_entrada(Salida *salida, const char *primero, const char *segundo, double valor) {
+    char numero[FORMATO_TAM_BUFER];
+    formato_double_exacto(valor, numero, sizeof(numero));
+    salida_append(salida, "    ");
+    escribir_nombre(salida, primero, 8);
+    salida_append(salida, "  ");
+    escribir_nombre(salida, segundo, 8);
+    salida_printf(salida, "  %12s\n", numero);
+}
+
+static void nombre_fila(int r, char *buffer, gsize tam) {
+    g_snprintf(buffer, tam, "R%d", r + 1);
+}
+
+// Escribe el modelo en MPS. Las filas se llaman R1..Rm y la función objetivo, OBJ.
+gboolean modelo_guardar_mps(const Modelo *modelo, const char *ruta) {
+    Salida *salida = salida_archivo(ruta);
+    if (!salida) {
+        g_printerr("Error: No se pudo abrir el archivo %s para escritura\n", ruta);
+        return FALSE;
+    }
+
+    char fila[32];
+    salida_append(salida, "NAME          ");
+    escribir_nombre(salida, modelo->nombre, 0);
+    salida_printf(salida, "\nOBJSENSE\n    %s\nROWS\n N  OBJ\n", modelo->tipo == MAXIMIZACION ? "MAX" : "MIN");
+    for (int r = 0; r < modelo->num_rest; r++) {
+        static const char *tipos[] = { "L", "G", "E" };
+        nombre_fila(r, fila, sizeof(fila));
+        salida_printf(salida, " %s  %s\n", tipos[modelo->tipos_restricciones[r]], fila);
+    }
+
+    salida_append(salida, "COLUMNS\n");
+    for (int j = 0; j < modelo->num_vars; j++) {
+        const char *variable = modelo->nombres_vars[j];
+        // Una columna sin coeficientes se declara con un 0 en el objetivo para no perderla
+        gboolean escrita = FALSE;
+        if (modelo->c[j] != 0.0 || modelo->num_rest == 0) {
+            escribir_entrada(salida, variable, "OBJ", modelo->c[j]);
+            escrita = TRUE;
+        }
+        for (int r = 0; r < modelo->num_rest; r++) {
+            if (modelo->A[r][j] == 0.0) continue;
+            nombre_fila(r, fila, sizeof(fila));
+            escribir_entrada(salida, variable, fila, modelo->A[r][j]);
+            escrita = TRUE;
+        }
+        if (!escrita) {
+            escribir_entrada(salida, variable, "OBJ", 0.0);
+        }
+    }
+
+    salida_append(salida, "RHS\n");
+    for (int r = 0; r < modelo->num_rest; r++) {
+        if (modelo->lados_derechos[r] == 0.0) continue;
+        nombre_fila(r, fila, sizeof(fila));
+        escribir_entrada(salida, "RHS", fila, modelo->lados_derechos[r]);
+    }
+    salida_append(salida, "ENDATA\n");
+
+    if (!salida_cerrar(salida)) {
+        g_printerr("Error: No se pudo escribir completo el archivo %s\n", ruta);
+        return FALSE;
+    }
+    return TRUE;
+}
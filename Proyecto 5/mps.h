@@ -0,0 +1,28 @@
+#ifndef MPS_H
+#define MPS_H
+
+#include <glib.h>
+#include "modelo.h"
+
+G_BEGIN_DECLS
+
+// Lectura y escritura de modelos en formato MPS (libre y fijo).
+//
+// El método simplex de este proyecto trabaja con x >= 0 y restricciones <=, >= o =,
+// así que al leer:
+//   - las filas con RANGES se convierten en dos restricciones;
+//   - las cotas LO > 0, UP, FX y BV se agregan como restricciones sobre la variable;
+//   - las cotas que permiten valores negativos (LO < 0, MI, FR) no se pueden
+//     representar y el archivo se rechaza;
+//   - las filas con lado derecho negativo se multiplican por -1;
+//   - la integralidad (MARKER, LI, UI, BV) se ignora;
+//   - un RHS distinto de cero en la fila objetivo (constante de Z) se rechaza.
+// OBJSENSE MAX/MIN se respeta; sin él el problema es de minimización.
+
+// Prototipos de funciones
+Modelo* modelo_cargar_mps(const char *ruta, gboolean formato_fijo);
+gboolean modelo_guardar_mps(const Modelo *modelo, const char *ruta);
+
+G_END_DECLS
+
+#endif
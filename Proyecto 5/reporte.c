@@ -0,0 +1,737 @@
+#include "reporte.h"
+#include "formato.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_GRANDE
+#define M_GRANDE 1.0e6
+#endif
+
+#ifndef EPSILON
+#define EPSILON 1.0e-10
+#endif
+
+// El contenido de los reportes HTML y Markdown es el mismo; solo cambia la marca
+typedef enum {
+    ESTILO_HTML,
+    ESTILO_MARKDOWN
+} EstiloReporte;
+
+typedef struct {
+    Salida *salida;
+    EstiloReporte estilo;
+} Reporte;
+
+// Resaltado de una celda de la tabla
+typedef enum {
+    CELDA_NORMAL,
+    CELDA_ENTRA,
+    CELDA_SALE,
+    CELDA_PIVOTE
+} TipoCelda;
+
+static const char ESTILO_CSS[] =
+    "body{font-family:sans-serif;max-width:60em;margin:2em auto;padding:0 1em;line-height:1.4}\n"
+    "table{border-collapse:collapse;margin:1em 0}\n"
+    "th,td{border:1px solid #999;padding:.25em .6em;text-align:right}\n"
+    "th{background:#eee}\n"
+    ".entra{background:#ff9696}.sale{background:#ffc864}.pivote{background:#c864ff}\n"
+    "math[display=block]{margin:.5em 0}\n";
+
+// ---------------- Primitivas de escritura ----------------
+
+static void escribir(Reporte *r, const char *texto) {
+    salida_append(r->salida, texto);
+}
+
+// Texto del usuario (nombres), escapado según el formato
+static void escribir_texto(Reporte *r, const char *texto) {
+    if (!texto) texto = "?";
+    for (const char *p = texto; *p; p++) {
+        char c = *p;
+        if (r->estilo == ESTILO_HTML) {
+            switch (c) {
+                case '&': escribir(r, "&amp;"); continue;
+                case '<': escribir(r, "&lt;"); continue;
+                case '>': escribir(r, "&gt;"); continue;
+                case '"': escribir(r, "&quot;"); continue;
+            }
+        } else if (strchr("\\`*_[]<>#|$", c)) {
+            salida_append_c(r->salida, '\\');
+        }
+        salida_append_c(r->salida, c);
+    }
+}
+
+static void escribir_numero(Reporte *r, double valor) {
+    char buffer[FORMATO_TAM_BUFER];
+    if (fabs(valor) < EPSILON) valor = 0.0;
+    formato_numero(valor, buffer, sizeof(buffer));
+    escribir(r, buffer);
+}
+
+static void titulo(Reporte *r, int nivel, const char *texto) {
+    if (r->estilo == ESTILO_HTML) {
+        salida_printf(r->salida, "<h%d>", nivel);
+        escribir_texto(r, texto);
+        salida_printf(r->salida, "</h%d>\n", nivel);
+    } else {
+        for (int i = 0; i < nivel; i++) salida_append_c(r->salida, '#');
+        salida_append_c(r->salida, ' ');
+        escribir_texto(r, texto);
+        escribir(r, "\n\n");
+    }
+}
+
+static void parrafo_inicio(Reporte *r) {
+    if (r->estilo == ESTILO_HTML) escribir(r, "<p>");
+}
+
+static void parrafo_fin(Reporte *r) {
+    escribir(r, r->estilo == ESTILO_HTML ? "</p>\n" : "\n\n");
+}
+
+static void negrita(Reporte *r, const char *texto) {
+    escribir(r, r->estilo == ESTILO_HTML ? "<strong>" : "**");
+    escribir(r, texto);
+    escribir(r, r->estilo == ESTILO_HTML ? "</strong>" : "**");
+}
+
+// Párrafo "Etiqueta: valor" con la etiqueta en negrita
+static void dato(Reporte *r, const char *etiqueta, const char *valor) {
+    parrafo_inicio(r);
+    negrita(r, etiqueta);
+    escribir(r, " ");
+    escribir_texto(r, valor);
+    parrafo_fin(r);
+}
+
+static void lista_inicio(Reporte *r) {
+    if (r->estilo == ESTILO_HTML) escribir(r, "<ul>\n");
+}
+
+static void elemento_inicio(Reporte *r) {
+    escribir(r, r->estilo == ESTILO_HTML ? "<li>" : "- ");
+}
+
+static void elemento_fin(Reporte *r) {
+    escribir(r, r->estilo == ESTILO_HTML ? "</li>\n" : "\n");
+}
+
+static void lista_fin(Reporte *r) {
+    escribir(r, r->estilo == ESTILO_HTML ? "</ul>\n" : "\n");
+}
+
+// ---------------- Nombres y expresiones matemáticas ----------------
+
+// Los nombres X3, S1, E2, A4 se muestran como x₃, s₁, e₂, a₄ (igual que en LaTeX)
+static gboolean nombre_con_subindice(const char *nombre, char *letra, int *indice) {
+    if (!nombre || nombre[0] == '\0' || !strchr("XxSsEeAa", nombre[0])) return FALSE;
+    char *fin;
+    long numero = strtol(nombre + 1, &fin, 10);
+    if (numero <= 0 || numero > G_MAXINT || *fin != '\0' || !g_ascii_isdigit(nombre[1])) return FALSE;
+    *letra = g_ascii_tolower(nombre[0]);
+    *indice = (int)numero;
+    return TRUE;
+}
+
+// Nombre de variable dentro de una expresión (MathML o LaTeX de Markdown)
+static void math_variable(Reporte *r, const char *nombre) {
+    char letra;
+    int indice;
+    gboolean subindice = nombre_con_subindice(nombre, &letra, &indice);
+
+    if (r->estilo == ESTILO_HTML) {
+        if (subindice) {
+            salida_printf(r->salida, "<msub><mi>%c</mi><mn>%d</mn></msub>", letra, indice);
+        } else {
+            escribir(r, "<mi>");
+            escribir_texto(r, nombre);
+            escribir(r, "</mi>");
+        }
+    } else if (subindice) {
+        salida_printf(r->salida, "%c_{%d}", letra, indice);
+    } else {
+        // Dentro de \text{} solo hay que proteger los caracteres especiales de LaTeX
+        escribir(r, "\\text{");
+        for (const char *p = nombre ? nombre : "?"; *p; p++) {
+            if (strchr("\\{}$&#^_%~", *p)) salida_append_c(r->salida, '\\');
+            salida_append_c(r->salida, *p);
+        }
+        escribir(r, "}");
+    }
+}
+
+static void math_numero(Reporte *r, double valor) {
+    if (r->estilo == ESTILO_HTML) {
+        // En MathML el signo es un operador aparte del número
+        if (valor <= -EPSILON) {
+            escribir(r, "<mo>&#8722;</mo>");
+            valor = -valor;
+        }
+        escribir(r, "<mn>");
+        escribir_numero(r, valor);
+        escribir(r, "</mn>");
+    } else {
+        escribir_numero(r, valor);
+    }
+}
+
+static void math_operador(Reporte *r, const char *html, const char *tex) {
+    if (r->estilo == ESTILO_HTML) {
+        salida_printf(r->salida, "<mo>%s</mo>", html);
+    } else {
+        salida_printf(r->salida, " %s ", tex);
+    }
+}
+
+static void math_inicio(Reporte *r, gboolean bloque) {
+    if (r->estilo == ESTILO_HTML) {
+        escribir(r, bloque ? "<math display=\"block\"><mrow>" : "<math><mrow>");
+    } else {
+        escribir(r, bloque ? "$$" : "$");
+    }
+}
+
+static void math_fin(Reporte *r, gboolean bloque) {
+    if (r->estilo == ESTILO_HTML) {
+        escribir(r, bloque ? "</mrow></math>\n" : "</mrow></math>");
+    } else {
+        escribir(r, bloque ? "$$\n\n" : "$");
+    }
+}
+
+// Variable suelta en el texto
+static void variable_en_texto(Reporte *r, const char *nombre) {
+    math_inicio(r, FALSE);
+    math_variable(r, nombre);
+    math_fin(r, FALSE);
+}
+
+// Combinación lineal sum(coef[i] * x_i), omitiendo los ceros y los coeficientes 1
+static void math_combinacion(Reporte *r, const double *coef, const char **nombres, int n) {
+    gboolean primero = TRUE;
+    for (int i = 0; i < n; i++) {
+        if (fabs(coef[i]) <= EPSILON) continue;
+
+        if (coef[i] < 0) {
+            math_operador(r, "&#8722;", "-");
+        } else if (!primero) {
+            math_operador(r, "+", "+");
+        }
+        if (fabs(fabs(coef[i]) - 1.0) > EPSILON) {
+            math_numero(r, fabs(coef[i]));
+        }
+        math_variable(r, nombres[i]);
+        primero = FALSE;
+    }
+    if (primero) {
+        math_numero(r, 0.0);
+    }
+}
+
+// ---------------- Tablas simplex ----------------
+
+static void celda_inicio(Reporte *r, gboolean encabezado, TipoCelda tipo) {
+    if (r->estilo == ESTILO_HTML) {
+        static const char *clases[] = { "", " class=\"entra\"", " class=\"sale\"", " class=\"pivote\"" };
+        salida_printf(r->salida, "<%s%s>", encabezado ? "th" : "td", clases[tipo]);
+    } else {
+        escribir(r, tipo == CELDA_NORMAL ? "| " : "| **");
+    }
+}
+
+static void celda_fin(Reporte *r, gboolean encabezado, TipoCelda tipo) {
+    if (r->estilo == ESTILO_HTML) {
+        escribir(r, encabezado ? "</th>" : "</td>");
+    } else {
+        escribir(r, tipo == CELDA_NORMAL ? " " : "** ");
+    }
+}
+
+static void fila_fin(Reporte *r) {
+    escribir(r, r->estilo == ESTILO_HTML ? "</tr>\n" : "|\n");
+}
+
+// Nombre de variable en una celda: subíndice HTML, o LaTeX en Markdown
+static void variable_en_celda(Reporte *r, const char *nombre) {
+    char letra;
+    int indice;
+    if (r->estilo == ESTILO_HTML && nombre_con_subindice(nombre, &letra, &indice)) {
+        salida_printf(r->salida, "%c<sub>%d</sub>", letra, indice);
+    } else if (r->estilo == ESTILO_HTML) {
+        escribir_texto(r, nombre);
+    } else {
+        variable_en_texto(r, nombre);
+    }
+}
+
+// Tabla simplex con la columna que entra, la fila que sale y el pivote resaltados.
+// Muestra las columnas que indiquen las opciones (ver ventana_columnas_reporte).
+static void tabla_simplex(Reporte *r, TablaSimplex *tabla, InfoPivote *pivote, const OpcionesReporte *opciones) {
+    if (!tabla || !tabla->tabla) return;
+    int columna_entra = (pivote && pivote->variable_entra) ? pivote->columna_pivote : -1;
+    int fila_sale = (pivote && pivote->variable_sale) ? pivote->fila_pivote : -1;
+    int num_columnas = 0;
+    int *columnas = ventana_columnas_reporte(tabla, opciones, columna_entra, &num_columnas);
+    int mostradas = columnas ? num_columnas : tabla->columnas - 1;
+    int col_b = tabla->columnas - 1;
+
+    // Encabezado
+    if (r->estilo == ESTILO_HTML) escribir(r, "<table>\n<tr>");
+    celda_inicio(r, TRUE, CELDA_NORMAL);
+    escribir(r, "Base");
+    celda_fin(r, TRUE, CELDA_NORMAL);
+    for (int k = 0; k < mostradas; k++) {
+        int j = columnas ? columnas[k] : k;
+        TipoCelda tipo = j == columna_entra ? CELDA_ENTRA : CELDA_NORMAL;
+        celda_inicio(r, TRUE, tipo);
+        variable_en_celda(r, obtener_nombre_variable(tabla, j));
+        celda_fin(r, TRUE, tipo);
+    }
+    celda_inicio(r, TRUE, CELDA_NORMAL);
+    escribir(r, "b");
+    celda_fin(r, TRUE, CELDA_NORMAL);
+    fila_fin(r);
+
+    if (r->estilo == ESTILO_MARKDOWN) {
+        for (int k = 0; k <= mostradas + 1; k++) escribir(r, "|---");
+        escribir(r, "|\n");
+    }
+
+    // Fila Z y filas de restricciones
+    for (int i = 0; i < tabla->filas; i++) {
+        if (r->estilo == ESTILO_HTML) escribir(r, "<tr>");
+        TipoCelda tipo_fila = (i > 0 && i == fila_sale) ? CELDA_SALE : CELDA_NORMAL;
+        celda_inicio(r, TRUE, tipo_fila);
+        if (i == 0) {
+            escribir(r, "Z");
+        } else {
+            variable_en_celda(r, obtener_nombre_variable(tabla, tabla->variables_base[i - 1]));
+        }
+        celda_fin(r, TRUE, tipo_fila);
+
+        for (int k = 0; k <= mostradas; k++) {
+            int j = k == mostradas ? col_b : (columnas ? columnas[k] : k);
+            TipoCelda tipo = tipo_fila;
+            if (j == columna_entra) tipo = (i == fila_sale) ? CELDA_PIVOTE : CELDA_ENTRA;
+
+            celda_inicio(r, FALSE, tipo);
+            if (i == 0) {
+                char buffer[FORMATO_TAM_BUFER];
+                formato_valor_gran_m(tabla->tabla[0][j], M_GRANDE, EPSILON, buffer, sizeof(buffer));
+                escribir(r, buffer);
+            } else {
+                escribir_numero(r, tabla->tabla[i][j]);
+            }
+            celda_fin(r, FALSE, tipo);
+        }
+        fila_fin(r);
+    }
+    escribir(r, r->estilo == ESTILO_HTML ? "</table>\n" : "\n");
+
+    if (columnas) {
+        parrafo_inicio(r);
+        salida_printf(r->salida, "Por el tamaño del problema se omiten %d columnas no básicas.",
+                      tabla->columnas - 1 - num_columnas);
+        parrafo_fin(r);
+    }
+    g_free(columnas);
+}
+
+// Razones b / a de la columna que entra
+static void calculos_pivote(Reporte *r, TablaSimplex *tabla, int columna_entra) {
+    parrafo_inicio(r);
+    negrita(r, "Cálculo de razones:");
+    parrafo_fin(r);
+
+    lista_inicio(r);
+    for (int i = 1; i < tabla->filas; i++) {
+        double elemento = tabla->tabla[i][columna_entra];
+        if (elemento <= EPSILON) continue;
+        double termino = tabla->tabla[i][tabla->columnas - 1];
+        elemento_inicio(r);
+        salida_printf(r->salida, "Fila %d: ", i);
+        escribir_numero(r, termino);
+        escribir(r, " / ");
+        escribir_numero(r, elemento);
+        escribir(r, " = ");
+        escribir_numero(r, termino / elemento);
+        elemento_fin(r);
+    }
+    lista_fin(r);
+}
+
+static void descripcion_pivote(Reporte *r, InfoPivote *pivote) {
+    if (!pivote || !pivote->variable_entra || !pivote->variable_sale) return;
+    parrafo_inicio(r);
+    escribir(r, "Entra ");
+    variable_en_texto(r, pivote->variable_entra);
+    escribir(r, ", sale ");
+    variable_en_texto(r, pivote->variable_sale);
+    salida_printf(r->salida, " (fila %d), elemento pivote ", pivote->fila_pivote);
+    escribir_numero(r, pivote->valor_pivote);
+    escribir(r, ".");
+    parrafo_fin(r);
+}
+
+// ---------------- Secciones ----------------
+
+static void seccion_problema(Reporte *r, ProblemaInfo *info) {
+    gboolean maximizar = strcmp(info->tipo_problema, "MAX") == 0;
+    char numero[16];
+
+    titulo(r, 2, "Formulación del Problema");
+    dato(r, "Problema:", info->nombre_problema);
+    dato(r, "Tipo:", maximizar ? "Maximización" : "Minimización");
+    g_snprintf(numero, sizeof(numero), "%d", info->num_vars);
+    dato(r, "Número de variables:", numero);
+    g_snprintf(numero, sizeof(numero), "%d", info->num_rest);
+    dato(r, "Número de restricciones:", numero);
+
+    titulo(r, 3, "Función Objetivo");
+    math_inicio(r, TRUE);
+    if (r->estilo == ESTILO_HTML) {
+        salida_printf(r->salida, "<mtext>%s</mtext><mspace width=\"0.5em\"/><mi>Z</mi><mo>=</mo>",
+                      maximizar ? "Maximizar" : "Minimizar");
+    } else {
+        salida_printf(r->salida, "\\text{%s } Z = ", maximizar ? "Maximizar" : "Minimizar");
+    }
+    math_combinacion(r, info->coef_obj, info->nombres_vars, info->num_vars);
+    math_fin(r, TRUE);
+
+    titulo(r, 3, "Restricciones");
+    for (int k = 0; k < info->num_rest; k++) {
+        math_inicio(r, TRUE);
+        math_combinacion(r, info->coef_rest[k], info->nombres_vars, info->num_vars);
+        switch (info->tipos_restricciones[k]) {
+            case RESTRICCION_GE: math_operador(r, "&#8805;", "\\geq"); break;
+            case RESTRICCION_EQ: math_operador(r, "=", "="); break;
+            default:             math_operador(r, "&#8804;", "\\leq"); break;
+        }
+        math_numero(r, info->lados_derechos[k]);
+        math_fin(r, TRUE);
+    }
+
+    titulo(r, 3, "Restricciones de No Negatividad");
+    math_inicio(r, TRUE);
+    for (int i = 0; i < info->num_vars; i++) {
+        if (i > 0) math_operador(r, ",", ",\\quad");
+        math_variable(r, info->nombres_vars[i]);
+        math_operador(r, "&#8805;", "\\geq");
+        math_numero(r, 0.0);
+    }
+    math_fin(r, TRUE);
+}
+
+static void seccion_metodo(Reporte *r, ResultadoSimplex *resultado) {
+    gboolean uso_gran_m = resultado->tablas_intermedias && resultado->num_tablas > 0 &&
+                          resultado->tablas_intermedias[0]->num_vars_artificiales > 0;
+
+    titulo(r, 2, "Método de Solución");
+    parrafo_inicio(r);
+    if (uso_gran_m) {
+        escribir(r, "Se utilizó el ");
+        negrita(r, "método de la Gran M");
+        salida_printf(r->salida, " (M = %.0f) debido a la presencia de restricciones de tipo ", M_GRANDE);
+        escribir(r, r->estilo == ESTILO_HTML ? "&#8805; o =." : "≥ o =.");
+    } else {
+        escribir(r, "Se utilizó el ");
+        negrita(r, "método simplex estándar");
+        escribir(r, ": todas las restricciones son del tipo ");
+        escribir(r, r->estilo == ESTILO_HTML ? "&#8804;" : "≤");
+        escribir(r, " y basta con variables de holgura.");
+    }
+    parrafo_fin(r);
+}
+
+static void seccion_iteraciones(Reporte *r, TablaSimplex **tablas, int num_tablas, const OpcionesReporte *opciones) {
+    int num_iteraciones = num_tablas - 2;
+    int completas = opciones ? opciones->iteraciones_completas : 0;
+    gboolean en_resumen = FALSE;
+    char texto[96];
+
+    titulo(r, 2, "Iteraciones del Método Simplex");
+    for (int i = 1; i <= num_iteraciones; i++) {
+        InfoPivote *pivote = calcular_info_pivote(tablas[i-1], tablas[i]);
+        gboolean resumida = completas > 0 && i > completas && i <= num_iteraciones - completas;
+
+        if (resumida) {
+            if (!en_resumen) {
+                g_snprintf(texto, sizeof(texto), "Iteraciones %d a %d (resumen)", i, num_iteraciones - completas);
+                titulo(r, 3, texto);
+                lista_inicio(r);
+                en_resumen = TRUE;
+            }
+            elemento_inicio(r);
+            salida_printf(r->salida, "Iteración %d: ", i);
+            if (pivote->variable_entra && pivote->variable_sale) {
+                escribir(r, "entra ");
+                variable_en_texto(r, pivote->variable_entra);
+                escribir(r, ", sale ");
+                variable_en_texto(r, pivote->variable_sale);
+                escribir(r, ", ");
+            }
+            char buffer[FORMATO_TAM_BUFER];
+            formato_valor_gran_m(tablas[i]->tabla[0][tablas[i]->columnas - 1], M_GRANDE, EPSILON, buffer, sizeof(buffer));
+            salida_printf(r->salida, "Z = %s", buffer);
+            elemento_fin(r);
+        } else {
+            if (en_resumen) {
+                lista_fin(r);
+                en_resumen = FALSE;
+            }
+            g_snprintf(texto, sizeof(texto), "Iteración %d", i);
+            titulo(r, 3, texto);
+            descripcion_pivote(r, pivote);
+            if (pivote->variable_entra) {
+                calculos_pivote(r, tablas[i-1], pivote->columna_pivote);
+            }
+            tabla_simplex(r, tablas[i-1], pivote, opciones);
+        }
+        liberar_info_pivote(pivote);
+    }
+    if (en_resumen) {
+        lista_fin(r);
+    }
+}
+
+static void seccion_tabla_final(Reporte *r, ResultadoSimplex *resultado, const OpcionesReporte *opciones) {
+    titulo(r, 2, "Tabla Final");
+    tabla_simplex(r, resultado->tablas_intermedias[resultado->num_tablas - 1], NULL, opciones);
+
+    const char *nota = NULL;
+    switch (resultado->tipo_solucion) {
+        case SOLUCION_OPTIMA:
+            if (resultado->es_degenerado) nota = "Problema degenerado: al menos una variable básica tiene valor cero.";
+            break;
+        case SOLUCION_MULTIPLE:
+            nota = "Solución múltiple: existen infinitas soluciones óptimas.";
+            break;
+        case SOLUCION_NO_ACOTADA:
+            nota = "Problema no acotado: la función objetivo puede mejorar indefinidamente.";
+            break;
+        case SOLUCION_NO_FACTIBLE:
+            nota = "Problema no factible: no existe solución que satisfaga todas las restricciones.";
+            break;
+        case SOLUCION_INTERRUMPIDA:
+            nota = "Resolución interrumpida: esta es la última tabla alcanzada, no necesariamente óptima.";
+            break;
+    }
+    if (nota) {
+        parrafo_inicio(r);
+        negrita(r, nota);
+        parrafo_fin(r);
+    }
+}
+
+// Valor de una variable en la tabla final (cero si no es básica)
+static double valor_en_tabla(TablaSimplex *tabla, int variable) {
+    for (int j = 0; j < tabla->num_restricciones; j++) {
+        if (tabla->variables_base[j] == variable) {
+            return tabla->tabla[j + 1][tabla->columnas - 1];
+        }
+    }
+    return 0.0;
+}
+
+static void lista_valores(Reporte *r, TablaSimplex *tabla, const double *solucion, ProblemaInfo *info) {
+    int total = tabla->num_vars_decision + tabla->num_vars_holgura +
+                tabla->num_vars_exceso + tabla->num_vars_artificiales;
+    lista_inicio(r);
+    for (int i = 0; i < total; i++) {
+        elemento_inicio(r);
+        variable_en_texto(r, i < info->num_vars ? info->nombres_vars[i] : obtener_nombre_variable(tabla, i));
+        escribir(r, " = ");
+        escribir_numero(r, (solucion && i < info->num_vars) ? solucion[i] : valor_en_tabla(tabla, i));
+        elemento_fin(r);
+    }
+    lista_fin(r);
+}
+
+// Combinaciones convexas lambda * x1 + (1 - lambda) * x2 de las dos soluciones básicas
+static void seccion_soluciones_adicionales(Reporte *r, ResultadoSimplex *resultado, ProblemaInfo *info) {
+    double *sol1 = g_new0(double, info->num_vars);
+    double *sol2 = g_new0(double, info->num_vars);
+    extraer_solucion(resultado->tablas_intermedias[resultado->num_tablas - 1], sol1);
+    extraer_solucion(resultado->segunda_tabla, sol2);
+
+    titulo(r, 3, "Soluciones Adicionales");
+    for (int k = 0; k < 3; k++) {
+        double lambda = (k + 1) * 0.25;
+        parrafo_inicio(r);
+        salida_printf(r->salida, "Con λ = %.2f: ", lambda);
+        for (int i = 0; i < info->num_vars; i++) {
+            if (i > 0) escribir(r, ", ");
+            variable_en_texto(r, info->nombres_vars[i]);
+            escribir(r, " = ");
+            escribir_numero(r, lambda * sol1[i] + (1.0 - lambda) * sol2[i]);
+        }
+        parrafo_fin(r);
+    }
+
+    g_free(sol1);
+    g_free(sol2);
+}
+
+static void seccion_resultados(Reporte *r, ResultadoSimplex *resultado, ProblemaInfo *info) {
+    if (resultado->tipo_solucion != SOLUCION_OPTIMA && resultado->tipo_solucion != SOLUCION_MULTIPLE) return;
+    TablaSimplex *tabla_final = resultado->tablas_intermedias[resultado->num_tablas - 1];
+    char valor[32];
+
+    titulo(r, 2, "Resultados");
+    g_snprintf(valor, sizeof(valor), "%.2f", resultado->valor_z);
+    dato(r, "Valor óptimo de Z:", valor);
+    parrafo_inicio(r);
+    negrita(r, "Valores de todas las variables:");
+    parrafo_fin(r);
+    lista_valores(r, tabla_final, resultado->solucion, info);
+
+    if (resultado->tipo_solucion == SOLUCION_MULTIPLE && resultado->segunda_tabla) {
+        titulo(r, 3, "Segunda Solución Básica Óptima");
+        parrafo_inicio(r);
+        escribir(r, "Cualquier combinación convexa de las dos soluciones básicas también es óptima.");
+        parrafo_fin(r);
+        lista_valores(r, resultado->segunda_tabla, NULL, info);
+
+        if (resultado->soluciones_adicionales && resultado->num_soluciones_adicionales > 0) {
+            seccion_soluciones_adicionales(r, resultado, info);
+        }
+    }
+}
+
+static void seccion_conclusion(Reporte *r, ResultadoSimplex *resultado) {
+    titulo(r, 2, "Conclusión");
+    parrafo_inicio(r);
+    switch (resultado->tipo_solucion) {
+        case SOLUCION_OPTIMA:
+            escribir(r, "El problema tiene una ");
+            negrita(r, "solución óptima única");
+            salida_printf(r->salida, ". El valor óptimo de la función objetivo es Z = %.2f.", resultado->valor_z);
+            break;
+        case SOLUCION_MULTIPLE:
+            escribir(r, "El problema tiene ");
+            negrita(r, "múltiples soluciones óptimas");
+            salida_printf(r->salida, ". El valor óptimo de la función objetivo es Z = %.2f; ", resultado->valor_z);
+            escribir(r, "existen infinitos puntos que alcanzan este valor.");
+            break;
+        case SOLUCION_NO_ACOTADA:
+            escribir(r, "El problema es ");
+            negrita(r, "no acotado");
+            escribir(r, ": la función objetivo puede mejorar indefinidamente sin violar las restricciones.");
+            break;
+        case SOLUCION_NO_FACTIBLE:
+            escribir(r, "El problema es ");
+            negrita(r, "no factible");
+            escribir(r, ": no existe ningún punto que satisfaga todas las restricciones.");
+            break;
+        case SOLUCION_INTERRUMPIDA:
+            escribir(r, "La resolución se ");
+            negrita(r, "interrumpió");
+            escribir(r, " antes de llegar a una conclusión.");
+            break;
+    }
+    parrafo_fin(r);
+}
+
+static void generar_documento(Reporte *r, ResultadoSimplex *resultado, ProblemaInfo *info,
+                              gboolean mostrar_tablas, const OpcionesReporte *opciones) {
+    if (r->estilo == ESTILO_HTML) {
+        escribir(r, "<!DOCTYPE html>\n<html lang=\"es\">\n<head>\n<meta charset=\"utf-8\">\n<title>");
+        escribir_texto(r, info->nombre_problema);
+        escribir(r, "</title>\n<style>\n");
+        escribir(r, ESTILO_CSS);
+        escribir(r, "</style>\n</head>\n<body>\n");
+    }
+
+    titulo(r, 1, "Método Simplex");
+    seccion_problema(r, info);
+    seccion_metodo(r, resultado);
+
+    TablaSimplex **tablas = resultado->tablas_intermedias;
+    if (tablas && resultado->num_tablas > 0) {
+        titulo(r, 2, "Tabla Inicial");
+        tabla_simplex(r, tablas[0], NULL, opciones);
+
+        if (mostrar_tablas && resultado->num_tablas > 2) {
+            seccion_iteraciones(r, tablas, resultado->num_tablas, opciones);
+        }
+        seccion_tabla_final(r, resultado, opciones);
+        seccion_resultados(r, resultado, info);
+    }
+    seccion_conclusion(r, resultado);
+
+    if (r->estilo == ESTILO_HTML) {
+        escribir(r, "</body>\n</html>\n");
+    }
+}
+
+// ---------------- Interfaz pública ----------------
+
+const char* extension_reporte(FormatoReporte formato) {
+    switch (formato) {
+        case REPORTE_HTML:     return "html";
+        case REPORTE_MARKDOWN: return "md";
+        default:               return "pdf";
+    }
+}
+
+// Acepta "pdf", "html" y "md"/"markdown" (sin importar mayúsculas)
+gboolean formato_reporte_desde_texto(const char *texto, FormatoReporte *formato) {
+    if (!texto) return FALSE;
+    if (g_ascii_strcasecmp(texto, "pdf") == 0) {
+        *formato = REPORTE_PDF;
+    } else if (g_ascii_strcasecmp(texto, "html") == 0) {
+        *formato = REPORTE_HTML;
+    } else if (g_ascii_strcasecmp(texto, "md") == 0 || g_ascii_strcasecmp(texto, "markdown") == 0) {
+        *formato = REPORTE_MARKDOWN;
+    } else {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+// Reporte HTML autocontenido: estilos en línea y fórmulas en MathML, sin scripts externos
+void generar_documento_html_salida(Salida *salida, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                   gboolean mostrar_tablas, const OpcionesReporte *opciones) {
+    Reporte reporte = { salida, ESTILO_HTML };
+    generar_documento(&reporte, resultado, info, mostrar_tablas, opciones);
+}
+
+// Reporte Markdown con tablas de tuberías y fórmulas $...$
+void generar_documento_markdown_salida(Salida *salida, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                       gboolean mostrar_tablas, const OpcionesReporte *opciones) {
+    Reporte reporte = { salida, ESTILO_MARKDOWN };
+    generar_documento(&reporte, resultado, info, mostrar_tablas, opciones);
+}
+
+// Escribe el reporte en 'ruta'. Para REPORTE_PDF escribe la fuente LaTeX, que después
+// se compila con compilar_latex o compilar_latex_async.
+gboolean generar_reporte(FormatoReporte formato, ResultadoSimplex *resultado, ProblemaInfo *info,
+                         const char *ruta, gboolean mostrar_tablas, const OpcionesReporte *opciones) {
+    Salida *salida = salida_archivo(ruta);
+    if (!salida) {
+        g_printerr("Error: No se pudo abrir el archivo %s para escritura\n", ruta);
+        return FALSE;
+    }
+
+    switch (formato) {
+        case REPORTE_HTML:
+            generar_documento_html_salida(salida, resultado, info, mostrar_tablas, opciones);
+            break;
+        case REPORTE_MARKDOWN:
+            generar_documento_markdown_salida(salida, resultado, info, mostrar_tablas, opciones);
+            break;
+        default:
+            generar_documento_latex_salida(salida, resultado, info, mostrar_tablas, opciones);
+            break;
+    }
+
+    if (!salida_cerrar(salida)) {
+        g_printerr("Error: No se pudo escribir completo el archivo %s\n", ruta);
+        return FALSE;
+    }
+    return TRUE;
+}
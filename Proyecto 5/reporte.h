@@ -0,0 +1,31 @@
+#ifndef REPORTE_H
+#define REPORTE_H
+
+#include <glib.h>
+#include "simplex.h"
+#include "latex.h"
+#include "salida.h"
+
+G_BEGIN_DECLS
+
+// Formatos del reporte. El PDF se genera como LaTeX y luego se compila con pdflatex;
+// HTML (con MathML) y Markdown se escriben directamente y no necesitan nada más.
+typedef enum {
+    REPORTE_PDF,
+    REPORTE_HTML,
+    REPORTE_MARKDOWN
+} FormatoReporte;
+
+// Prototipos de funciones
+const char* extension_reporte(FormatoReporte formato);
+gboolean formato_reporte_desde_texto(const char *texto, FormatoReporte *formato);
+void generar_documento_html_salida(Salida *salida, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                   gboolean mostrar_tablas, const OpcionesReporte *opciones);
+void generar_documento_markdown_salida(Salida *salida, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                       gboolean mostrar_tablas, const OpcionesReporte *opciones);
+gboolean generar_reporte(FormatoReporte formato, ResultadoSimplex *resultado, ProblemaInfo *info,
+                         const char *ruta, gboolean mostrar_tablas, const OpcionesReporte *opciones);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,169 @@
+#include "salida.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+
+struct Salida {
+    int fd;                 // -1 en modo memoria
+    gboolean cerrar_fd;
+    gboolean error;
+    gsize usado;
+    char *bufer;
+    GString *memoria;       // Solo en modo memoria
+};
+
+Salida* salida_fd(int fd, gboolean cerrar_fd) {
+    Salida *salida = g_new0(Salida, 1);
+    salida->fd = fd;
+    salida->cerrar_fd = cerrar_fd;
+    salida->bufer = g_malloc(SALIDA_TAM_BUFER);
+    return salida;
+}
+
+// Devuelve NULL si no se puede abrir el archivo
+Salida* salida_archivo(const char *ruta) {
+    int fd = open(ruta, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return NULL;
+    }
+    return salida_fd(fd, TRUE);
+}
+
+Salida* salida_memoria(void) {
+    Salida *salida = g_new0(Salida, 1);
+    salida->fd = -1;
+    salida->memoria = g_string_new("");
+    return salida;
+}
+
+static void escribir_todo(Salida *salida, const char *datos, gsize largo) {
+    while (largo > 0 && !salida->error) {
+        ssize_t escrito = write(salida->fd, datos, largo);
+        if (escrito < 0) {
+            if (errno == EINTR) continue;
+            salida->error = TRUE;   // p. ej. EPIPE si pdflatex terminó antes
+            break;
+        }
+        datos += escrito;
+        largo -= (gsize)escrito;
+    }
+}
+
+// Escribe lo que haya en el búfer
+gboolean salida_vaciar(Salida *salida) {
+    if (salida->memoria) return TRUE;
+    
+    escribir_todo(salida, salida->bufer, salida->usado);
+    salida->usado = 0;
+    return !salida->error;
+}
+
+void salida_append_len(Salida *salida, const char *texto, gsize largo) {
+    if (salida->memoria) {
+        g_string_append_len(salida->memoria, texto, (gssize)largo);
+        return;
+    }
+    
+    if (salida->usado + largo > SALIDA_TAM_BUFER) {
+        salida_vaciar(salida);
+        if (largo >= SALIDA_TAM_BUFER) {
+            escribir_todo(salida, texto, largo);
+            return;
+        }
+    }
+    memcpy(salida->bufer + salida->usado, texto, largo);
+    salida->usado += largo;
+}
+
+void salida_append(Salida *salida, const char *texto) {
+    salida_append_len(salida, texto, strlen(texto));
+}
+
+void salida_append_c(Salida *salida, char c) {
+    salida_append_len(salida, &c, 1);
+}
+
+// Enteros y doubles en little-endian, para los formatos binarios
+void salida_binario_u16(Salida *salida, guint16 valor) {
+    guint16 le = GUINT16_TO_LE(valor);
+    salida_append_len(salida, (const char*)&le, sizeof(le));
+}
+
+void salida_binario_u32(Salida *salida, guint32 valor) {
+    guint32 le = GUINT32_TO_LE(valor);
+    salida_append_len(salida, (const char*)&le, sizeof(le));
+}
+
+void salida_binario_double(Salida *salida, double valor) {
+    guint64 bits;
+    memcpy(&bits, &valor, sizeof(bits));
+    bits = GUINT64_TO_LE(bits);
+    salida_append_len(salida, (const char*)&bits, sizeof(bits));
+}
+
+void salida_binario_doubles(Salida *salida, const double *valores, int n) {
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+    salida_append_len(salida, (const char*)valores, sizeof(double) * (gsize)n);
+#else
+    for (int i = 0; i < n; i++) salida_binario_double(salida, valores[i]);
+#endif
+}
+
+void salida_printf(Salida *salida, const char *formato, ...) {
+    va_list args;
+    
+    if (salida->memoria) {
+        va_start(args, formato);
+        g_string_append_vprintf(salida->memoria, formato, args);
+        va_end(args);
+        return;
+    }
+    
+    // La mayoría de las líneas caben en el espacio libre del búfer
+    gsize libre = SALIDA_TAM_BUFER - salida->usado;
+    va_start(args, formato);
+    int largo = g_vsnprintf(salida->bufer + salida->usado, (gulong)libre, formato, args);
+    va_end(args);
+    if (largo < 0) return;
+    
+    if ((gsize)largo < libre) {
+        salida->usado += (gsize)largo;
+        return;
+    }
+    
+    va_start(args, formato);
+    gchar *texto = g_strdup_vprintf(formato, args);
+    va_end(args);
+    salida_append_len(salida, texto, (gsize)largo);
+    g_free(texto);
+}
+
+// Vacía el búfer, cierra el destino y libera la salida. Devuelve FALSE si hubo errores.
+gboolean salida_cerrar(Salida *salida) {
+    if (!salida) return FALSE;
+    
+    gboolean ok = salida_vaciar(salida);
+    if (salida->memoria) {
+        g_string_free(salida->memoria, TRUE);
+    } else if (salida->cerrar_fd && close(salida->fd) != 0) {
+        ok = FALSE;
+    }
+    g_free(salida->bufer);
+    g_free(salida);
+    return ok;
+}
+
+// Para el modo memoria: devuelve el texto acumulado (se libera con g_free)
+gchar* salida_cerrar_memoria(Salida *salida, gsize *largo) {
+    if (!salida || !salida->memoria) {
+        salida_cerrar(salida);
+        return NULL;
+    }
+    
+    if (largo) *largo = salida->memoria->len;
+    gchar *texto = g_string_free(salida->memoria, FALSE);
+    g_free(salida);
+    return texto;
+}
@@ -0,0 +1,34 @@
+#ifndef SALIDA_H
+#define SALIDA_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+// Destino con búfer para todo lo que escribe la biblioteca: reportes, modelos y
+// resultados, en texto (salida_append, salida_printf) o binario little-endian
+// (salida_binario_*). Puede ser un archivo, un descriptor o memoria; en archivo y
+// descriptor la memoria usada es la del búfer, sin importar el tamaño de la salida.
+typedef struct Salida Salida;
+
+#define SALIDA_TAM_BUFER (64 * 1024)
+
+// Prototipos de funciones
+Salida* salida_archivo(const char *ruta);
+Salida* salida_fd(int fd, gboolean cerrar_fd);
+Salida* salida_memoria(void);
+void salida_append_len(Salida *salida, const char *texto, gsize largo);
+void salida_append(Salida *salida, const char *texto);
+void salida_append_c(Salida *salida, char c);
+void salida_binario_u16(Salida *salida, guint16 valor);
+void salida_binario_u32(Salida *salida, guint32 valor);
+void salida_binario_double(Salida *salida, double valor);
+void salida_binario_doubles(Salida *salida, const double *valores, int n);
+void salida_printf(Salida *salida, const char *formato, ...) G_GNUC_PRINTF(2, 3);
+gboolean salida_vaciar(Salida *salida);
+gboolean salida_cerrar(Salida *salida);
+gchar* salida_cerrar_memoria(Salida *salida, gsize *largo);
+
+G_END_DECLS
+
+#endif
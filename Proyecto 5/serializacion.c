@@ -0,0 +1,328 @@
+#include "serializacion.h"
+#include "formato.h"
+#include <math.h>
+#include <string.h>
+
+// Lo que se escribe de un resultado, calculado una sola vez para ambos formatos
+typedef struct {
+    gboolean con_solucion;
+    int n;
+    int m;
+    TablaSimplex *inicial;
+    TablaSimplex *final;
+    double *x;
+    double *holguras;
+    double *duales;
+} ResumenResultado;
+
+static const char* estado_texto(TipoSolucion tipo) {
+    switch (tipo) {
+        case SOLUCION_OPTIMA:      return "optima";
+        case SOLUCION_MULTIPLE:    return "multiple";
+        case SOLUCION_NO_ACOTADA:  return "no_acotada";
+        case SOLUCION_NO_FACTIBLE: return "no_factible";
+        default:                   return "interrumpida";
+    }
+}
+
+static void resumir(ResultadoSimplex *resultado, ProblemaInfo *info, ResumenResultado *resumen) {
+    int n = info->num_vars;
+    int m = info->num_rest;
+
+    resumen->n = n;
+    resumen->m = m;
+    resumen->inicial = resultado->num_tablas > 0 ? resultado->tablas_intermedias[0] : NULL;
+    resumen->final = resultado->num_tablas > 0 ? resultado->tablas_intermedias[resultado->num_tablas - 1] : NULL;
+    resumen->con_solucion = resultado->solucion && resumen->final &&
+                            (resultado->tipo_solucion == SOLUCION_OPTIMA ||
+                             resultado->tipo_solucion == SOLUCION_MULTIPLE);
+    resumen->x = g_new(double, n);
+    resumen->holguras = g_new(double, m);
+    resumen->duales = g_new(double, m);
+
+    if (!resumen->con_solucion) {
+        for (int j = 0; j < n; j++) resumen->x[j] = NAN;
+        for (int i = 0; i < m; i++) resumen->holguras[i] = resumen->duales[i] = NAN;
+        return;
+    }
+
+    memcpy(resumen->x, resultado->solucion, sizeof(double) * n);
+
+    // Las filas de la tabla inicial son A y b tal como se armó el problema, así que las
+    // holguras no necesitan la copia densa del modelo (info->coef_rest puede ser NULL)
+    TablaSimplex *inicial = resumen->inicial;
+    for (int i = 0; i < m; i++) {
+        const double *fila = inicial->tabla[i + 1];
+        double actividad = 0.0;
+        for (int j = 0; j < n; j++) {
+            actividad += fila[j] * resumen->x[j];
+        }
+        resumen->holguras[i] = fila[inicial->columnas - 1] - actividad;
+    }
+
+    // y = c_B B^-1. La columna i de B^-1 está en la tabla final, en la columna de la
+    // variable que era básica en la fila i de la tabla inicial (holgura o artificial).
+    TablaSimplex *final = resumen->final;
+    for (int i = 0; i < m; i++) {
+        int columna = resumen->inicial->variables_base[i];
+        double dual = 0.0;
+        for (int k = 0; k < m; k++) {
+            int variable = final->variables_base[k];
+            if (variable < n) {
+                dual += info->coef_obj[variable] * final->tabla[k + 1][columna];
+            }
+        }
+        resumen->duales[i] = fabs(dual) < 1e-12 ? 0.0 : dual;
+    }
+}
+
+static void liberar_resumen(ResumenResultado *resumen) {
+    g_free(resumen->x);
+    g_free(resumen->holguras);
+    g_free(resumen->duales);
+}
+
+// ---------------- JSON ----------------
+
+static void json_texto(Salida *salida, const char *texto) {
+    salida_append_c(salida, '"');
+    for (const guchar *p = (const guchar*)(texto ? texto : ""); *p; p++) {
+        switch (*p) {
+            case '"':  salida_append(salida, "\\\""); break;
+            case '\\': salida_append(salida, "\\\\"); break;
+            case '\n': salida_append(salida, "\\n"); break;
+            case '\r': salida_append(salida, "\\r"); break;
+            case '\t': salida_append(salida, "\\t"); break;
+            default:
+                if (*p < 0x20) {
+                    salida_printf(salida, "\\u%04x", *p);
+                } else {
+                    salida_append_c(salida, (char)*p);
+                }
+        }
+    }
+    salida_append_c(salida, '"');
+}
+
+// Número con todos sus dígitos (se lee de vuelta al mismo double); NaN e infinito son null
+static void json_numero(Salida *salida, double valor) {
+    if (!isfinite(valor)) {
+        salida_append(salida, "null");
+        return;
+    }
+    char buffer[FORMATO_TAM_BUFER];
+    gsize largo = formato_double_exacto(valor, buffer, sizeof(buffer));
+    salida_append_len(salida, buffer, largo);
+}
+
+static void json_arreglo(Salida *salida, const char *clave, const double *valores, int n, gboolean presente) {
+    salida_printf(salida, ",\n  \"%s\": ", clave);
+    if (!presente) {
+        salida_append(salida, "null");
+        return;
+    }
+    salida_append_c(salida, '[');
+    for (int i = 0; i < n; i++) {
+        if (i > 0) salida_append(salida, ", ");
+        json_numero(salida, valores[i]);
+    }
+    salida_append_c(salida, ']');
+}
+
+// Los nombres de las variables de decisión son los del usuario; los demás, los de la tabla
+static const char* nombre_variable(TablaSimplex *tabla, ProblemaInfo *info, int indice) {
+    if (indice < info->num_vars) return info->nombres_vars[indice];
+    return obtener_nombre_variable(tabla, indice);
+}
+
+// Esquema estable (versión SERIALIZACION_VERSION): las claves no cambian de nombre ni
+// de significado; las versiones nuevas solo pueden agregar claves.
+void resultado_json_salida(Salida *salida, ResultadoSimplex *resultado, ProblemaInfo *info,
+                           gboolean incluir_pivotes) {
+    ResumenResultado resumen;
+    resumir(resultado, info, &resumen);
+
+    salida_printf(salida, "{\n  \"formato\": \"simplex-resultado\",\n  \"version\": %d,\n", SERIALIZACION_VERSION);
+    salida_append(salida, "  \"problema\": {\"nombre\": ");
+    json_texto(salida, info->nombre_problema);
+    salida_append(salida, ", \"tipo\": ");
+    json_texto(salida, info->tipo_problema);
+    salida_append(salida, ", \"variables\": [");
+    for (int j = 0; j < info->num_vars; j++) {
+        if (j > 0) salida_append(salida, ", ");
+        json_texto(salida, info->nombres_vars[j]);
+    }
+    salida_printf(salida, "], \"restricciones\": %d},\n", info->num_rest);
+
+    salida_append(salida, "  \"estado\": ");
+    json_texto(salida, estado_texto(resultado->tipo_solucion));
+    salida_append(salida, ",\n  \"mensaje\": ");
+    json_texto(salida, resultado->mensaje);
+    salida_append(salida, ",\n  \"z\": ");
+    if (resumen.con_solucion || resultado->tipo_solucion == SOLUCION_INTERRUMPIDA) {
+        json_numero(salida, resultado->valor_z);
+    } else {
+        salida_append(salida, "null");
+    }
+
+    json_arreglo(salida, "x", resumen.x, resumen.n, resumen.con_solucion);
+    json_arreglo(salida, "holguras", resumen.holguras, resumen.m, resumen.con_solucion);
+
+    // Base de la última tabla, fila por fila
+    salida_append(salida, ",\n  \"base\": [");
+    if (resumen.final) {
+        TablaSimplex *final = resumen.final;
+        for (int i = 0; i < final->num_restricciones; i++) {
+            int variable = final->variables_base[i];
+            salida_append(salida, i > 0 ? ",\n    " : "\n    ");
+            salida_printf(salida, "{\"fila\": %d, \"variable\": %d, \"nombre\": ", i + 1, variable);
+            json_texto(salida, nombre_variable(final, info, variable));
+            salida_append(salida, ", \"valor\": ");
+            json_numero(salida, final->tabla[i + 1][final->columnas - 1]);
+            salida_append_c(salida, '}');
+        }
+        if (final->num_restricciones > 0) salida_append(salida, "\n  ");
+    }
+    salida_append_c(salida, ']');
+
+    json_arreglo(salida, "duales", resumen.duales, resumen.m, resumen.con_solucion);
+
+    salida_printf(salida, ",\n  \"estadisticas\": {\"iteraciones\": %d, \"degenerado\": %s, "
+                                "\"columnas\": %d, \"tablas_guardadas\": %d}",
+                        resultado->iteraciones, resultado->es_degenerado ? "true" : "false",
+                        resumen.final ? resumen.final->columnas - 1 : 0, resultado->num_tablas);
+
+    if (incluir_pivotes && resultado->pivotes) {
+        salida_append(salida, ",\n  \"pivotes\": [");
+        for (int k = 0; k < resultado->iteraciones; k++) {
+            PivoteSimplex *pivote = &resultado->pivotes[k];
+            salida_append(salida, k > 0 ? ",\n    " : "\n    ");
+            salida_printf(salida, "{\"iteracion\": %d, \"columna\": %d, \"entra\": ", k + 1, pivote->columna);
+            json_texto(salida, nombre_variable(resumen.final, info, pivote->columna));
+            salida_printf(salida, ", \"fila\": %d, \"sale\": ", pivote->fila);
+            json_texto(salida, nombre_variable(resumen.final, info, pivote->variable_sale));
+            salida_append(salida, ", \"pivote\": ");
+            json_numero(salida, pivote->valor);
+            salida_append(salida, ", \"z\": ");
+            json_numero(salida, pivote->valor_z);
+            salida_append_c(salida, '}');
+        }
+        salida_append(salida, resultado->iteraciones > 0 ? "\n  ]" : "]");
+    }
+
+    salida_append(salida, "\n}\n");
+    liberar_resumen(&resumen);
+}
+
+// ---------------- Binario ----------------
+
+void resultado_binario_salida(Salida *salida, ResultadoSimplex *resultado, ProblemaInfo *info,
+                              gboolean incluir_pivotes) {
+    ResumenResultado resumen;
+    resumir(resultado, info, &resumen);
+    gboolean con_pivotes = incluir_pivotes && resultado->pivotes;
+
+    guint16 banderas = 0;
+    if (resumen.con_solucion) banderas |= RESULTADO_BINARIO_CON_SOLUCION;
+    if (resultado->es_degenerado) banderas |= RESULTADO_BINARIO_DEGENERADO;
+    if (con_pivotes) banderas |= RESULTADO_BINARIO_CON_PIVOTES;
+
+    salida_append_len(salida, RESULTADO_BINARIO_MAGIA, 4);
+    salida_binario_u16(salida, SERIALIZACION_VERSION);
+    salida_binario_u16(salida, banderas);
+    salida_binario_u32(salida, (guint32)resultado->tipo_solucion);
+    salida_binario_u32(salida, (guint32)resumen.n);
+    salida_binario_u32(salida, (guint32)resumen.m);
+    salida_binario_u32(salida, (guint32)resultado->iteraciones);
+    salida_binario_u32(salida, con_pivotes ? (guint32)resultado->iteraciones : 0);
+    salida_binario_u32(salida, g_strcmp0(info->tipo_problema, "MIN") == 0 ? MINIMIZACION : MAXIMIZACION);
+    salida_binario_double(salida, (resumen.con_solucion || resultado->tipo_solucion == SOLUCION_INTERRUMPIDA) ?
+                           resultado->valor_z : NAN);
+
+    salida_binario_doubles(salida, resumen.x, resumen.n);
+    salida_binario_doubles(salida, resumen.holguras, resumen.m);
+    salida_binario_doubles(salida, resumen.duales, resumen.m);
+
+    for (int i = 0; i < resumen.m; i++) {
+        salida_binario_u32(salida, resumen.final ? (guint32)resumen.final->variables_base[i] : G_MAXUINT32);
+    }
+    if (resumen.m % 2 != 0) {
+        salida_binario_u32(salida, 0);
+    }
+
+    if (con_pivotes) {
+        for (int k = 0; k < resultado->iteraciones; k++) {
+            PivoteSimplex *pivote = &resultado->pivotes[k];
+            salida_binario_u32(salida, (guint32)pivote->columna);
+            salida_binario_u32(salida, (guint32)pivote->fila);
+            salida_binario_u32(salida, (guint32)pivote->variable_sale);
+            salida_binario_u32(salida, 0);
+            salida_binario_double(salida, pivote->valor);
+            salida_binario_double(salida, pivote->valor_z);
+        }
+    }
+
+    liberar_resumen(&resumen);
+}
+
+// Ubica los arreglos de un resultado binario sin copiarlos. 'datos' debe estar alineado
+// a 8 bytes (como lo dejan g_malloc y GMappedFile). Solo en máquinas little-endian:
+// en las demás hay que convertir los campos uno por uno.
+gboolean resultado_binario_vista(gconstpointer datos, gsize largo, VistaResultadoBinario *vista) {
+#if G_BYTE_ORDER != G_LITTLE_ENDIAN
+    return FALSE;
+#endif
+    const guint8 *bytes = datos;
+    if (!bytes || largo < sizeof(CabeceraResultadoBinario) || ((guintptr)bytes % 8) != 0) return FALSE;
+
+    const CabeceraResultadoBinario *cabecera = datos;
+    if (memcmp(cabecera->magia, RESULTADO_BINARIO_MAGIA, 4) != 0 ||
+        cabecera->version != SERIALIZACION_VERSION) {
+        return FALSE;
+    }
+
+    guint64 n = cabecera->num_vars;
+    guint64 m = cabecera->num_restricciones;
+    guint64 desplazamiento = sizeof(CabeceraResultadoBinario);
+    guint64 esperado = desplazamiento + 8 * (n + 2 * m) + 4 * (m + m % 2) +
+                       sizeof(PivoteResultadoBinario) * (guint64)cabecera->num_pivotes;
+    if (esperado != largo) return FALSE;
+
+    vista->cabecera = cabecera;
+    vista->x = (const double*)(bytes + desplazamiento);
+    vista->holguras = vista->x + n;
+    vista->duales = vista->holguras + m;
+    vista->base = (const gint32*)(vista->duales + m);
+    vista->pivotes = cabecera->num_pivotes > 0 ?
+                     (const PivoteResultadoBinario*)(vista->base + m + m % 2) : NULL;
+    return TRUE;
+}
+
+// ---------------- Archivos ----------------
+
+typedef void (*EscritorResultado)(Salida*, ResultadoSimplex*, ProblemaInfo*, gboolean);
+
+static gboolean guardar(const char *ruta, EscritorResultado escritor, ResultadoSimplex *resultado,
+                        ProblemaInfo *info, gboolean incluir_pivotes) {
+    Salida *salida = salida_archivo(ruta);
+    if (!salida) {
+        g_printerr("Error: No se pudo abrir el archivo %s para escritura\n", ruta);
+        return FALSE;
+    }
+    escritor(salida, resultado, info, incluir_pivotes);
+    if (!salida_cerrar(salida)) {
+        g_printerr("Error: No se pudo escribir completo el archivo %s\n", ruta);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+gboolean resultado_guardar_json(const char *ruta, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                gboolean incluir_pivotes) {
+    return guardar(ruta, resultado_json_salida, resultado, info, incluir_pivotes);
+}
+
+gboolean resultado_guardar_binario(const char *ruta, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                   gboolean incluir_pivotes) {
+    return guardar(ruta, resultado_binario_salida, resultado, info, incluir_pivotes);
+}
@@ -0,0 +1,87 @@
+#ifndef SERIALIZACION_H
+#define SERIALIZACION_H
+
+#include <glib.h>
+#include "simplex.h"
+#include "salida.h"
+
+G_BEGIN_DECLS
+
+// Resultado de una resolución en formato legible por máquina: JSON y binario.
+// Ambos llevan lo mismo: estado, Z, x, holguras (b - Ax), base, precios duales
+// (c_B B^-1, en unidades de la función objetivo original), estadísticas y,
+// opcionalmente, el registro de pivotes.
+
+#define SERIALIZACION_VERSION 1
+
+// Formato binario, todo en little-endian y alineado a 8 bytes:
+//
+//   CabeceraResultadoBinario                      40 bytes
+//   double x[n]                                   (NaN si no hay solución)
+//   double holguras[m]                            (NaN si no hay solución)
+//   double duales[m]                              (NaN si no hay solución)
+//   gint32 base[m], más 4 bytes de relleno si m es impar
+//   PivoteResultadoBinario pivotes[num_pivotes]   32 bytes cada uno
+//
+// El tamaño depende solo de n, m y num_pivotes, así que cada arreglo se ubica
+// sin recorrer el archivo.
+#define RESULTADO_BINARIO_MAGIA "SPXR"
+
+enum {
+    RESULTADO_BINARIO_CON_SOLUCION = 1 << 0,
+    RESULTADO_BINARIO_DEGENERADO   = 1 << 1,
+    RESULTADO_BINARIO_CON_PIVOTES  = 1 << 2
+};
+
+typedef struct {
+    char magia[4];              // "SPXR"
+    guint16 version;
+    guint16 banderas;           // RESULTADO_BINARIO_*
+    guint32 estado;             // TipoSolucion
+    guint32 num_vars;           // n
+    guint32 num_restricciones;  // m
+    guint32 iteraciones;
+    guint32 num_pivotes;        // iteraciones, o 0 sin registro de pivotes
+    guint32 tipo;               // TipoProblema
+    double valor_z;
+} CabeceraResultadoBinario;
+
+typedef struct {
+    gint32 columna;             // Variable que entra
+    gint32 fila;                // 1..m
+    gint32 variable_sale;
+    gint32 reservado;
+    double valor;               // Elemento pivote
+    double valor_z;             // Z después del pivote
+} PivoteResultadoBinario;
+
+G_STATIC_ASSERT(sizeof(CabeceraResultadoBinario) == 40);
+G_STATIC_ASSERT(sizeof(PivoteResultadoBinario) == 32);
+
+// Vista de un resultado binario en memoria: los punteros apuntan dentro del búfer
+typedef struct {
+    const CabeceraResultadoBinario *cabecera;
+    const double *x;
+    const double *holguras;
+    const double *duales;
+    const gint32 *base;
+    const PivoteResultadoBinario *pivotes;
+} VistaResultadoBinario;
+
+// De 'info' solo se usan el nombre, el tipo, las dimensiones, nombres_vars y coef_obj;
+// A y b salen de la tabla inicial del resultado.
+
+// Prototipos de funciones
+void resultado_json_salida(Salida *salida, ResultadoSimplex *resultado, ProblemaInfo *info,
+                           gboolean incluir_pivotes);
+void resultado_binario_salida(Salida *salida, ResultadoSimplex *resultado, ProblemaInfo *info,
+                              gboolean incluir_pivotes);
+gboolean resultado_guardar_json(const char *ruta, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                gboolean incluir_pivotes);
+gboolean resultado_guardar_binario(const char *ruta, ResultadoSimplex *resultado, ProblemaInfo *info,
+                                   gboolean incluir_pivotes);
+gboolean resultado_binario_vista(gconstpointer datos, gsize largo, VistaResultadoBinario *vista);
+
+G_END_DECLS
+
+#endif
@@ -8,11 +8,25 @@
 #define EPSILON 1.0e-10
 #define MAX_ITERACIONES 1000
 
-// Función auxiliar para copiar una tabla
-static TablaSimplex* copiar_tabla(TablaSimplex *original) {
+// Reserva una matriz contigua en la arena (una sola reserva para todas las filas)
+static double** reservar_matriz(Arena *arena, int filas, int columnas) {
+    double **matriz = arena_new0(arena, double*, filas);
+    double *celdas = arena_new0(arena, double, (gsize)filas * columnas);
+    for (int i = 0; i < filas; i++) {
+        matriz[i] = celdas + (gsize)i * columnas;
+    }
+    return matriz;
+}
+
+// Función auxiliar para copiar una tabla dentro de la arena indicada. La copia comparte
+// los nombres del original sin tomar una referencia: solo se usa para las tablas de un
+// resultado, que ya tiene la suya (ver TablaNombres en simplex.h).
+static TablaSimplex* copiar_tabla(Arena *arena, TablaSimplex *original) {
     if (!original) return NULL;
     
-    TablaSimplex *copia = g_new0(TablaSimplex, 1);
+    TablaSimplex *copia = arena_new0(arena, TablaSimplex, 1);
+    copia->arena = arena;
+    copia->arena_propia = FALSE;
     
     copia->filas = original->filas;
     copia->columnas = original->columnas;
@@ -24,54 +38,87 @@ static TablaSimplex* copiar_tabla(TablaSimplex *original) {
     copia->tipo = original->tipo;
     
     if (original->tabla) {
-        copia->tabla = g_new0(double*, copia->filas);
+        copia->tabla = reservar_matriz(arena, copia->filas, copia->columnas);
         for (int i = 0; i < copia->filas; i++) {
-            copia->tabla[i] = g_new0(double, copia->columnas);
-            for (int j = 0; j < copia->columnas; j++) {
-                copia->tabla[i][j] = original->tabla[i][j];
-            }
+            memcpy(copia->tabla[i], original->tabla[i], sizeof(double) * copia->columnas);
         }
     }
     
-    if (original->variables_base) {
-        copia->variables_base = g_new0(int, copia->num_restricciones);
-        for (int i = 0; i < copia->num_restricciones; i++) {
-            copia->variables_base[i] = original->variables_base[i];
-        }
-    }
+    copia->variables_base = arena_memdup(arena, original->variables_base, 
+                                         sizeof(int) * copia->num_restricciones);
     
-    if (original->nombres_vars) {
+    // Los nombres no cambian después de preparar la tabla: la copia comparte la misma tabla de nombres
+    copia->nombres = original->nombres;
+    
+    if (original->es_artificial) {
         int total_vars = copia->num_vars_decision + copia->num_vars_holgura + 
                         copia->num_vars_exceso + copia->num_vars_artificiales;
-        copia->nombres_vars = g_new0(char*, total_vars);
-        copia->es_artificial = g_new0(int, total_vars);
-        
-        for (int i = 0; i < total_vars; i++) {
-            if (original->nombres_vars[i]) {
-                copia->nombres_vars[i] = g_strdup(original->nombres_vars[i]);
-            }
-            copia->es_artificial[i] = original->es_artificial[i];
-        }
+        copia->es_artificial = arena_memdup(arena, original->es_artificial, sizeof(int) * total_vars);
     }
     
     return copia;
 }
 
+// Crea la tabla de nombres x1..xn, s1.., e1.., a1.. con una sola reserva de memoria
+TablaNombres* tabla_nombres_nueva(int num_decision, int num_holgura, int num_exceso, int num_artificiales) {
+    const char prefijos[4] = { 'x', 's', 'e', 'a' };
+    const int cantidades[4] = { num_decision, num_holgura, num_exceso, num_artificiales };
+    int total = num_decision + num_holgura + num_exceso + num_artificiales;
+    
+    gsize largo_texto = 0;
+    for (int g = 0; g < 4; g++) {
+        for (int i = 0; i < cantidades[g]; i++) {
+            largo_texto += g_snprintf(NULL, 0, "%c%d", prefijos[g], i + 1) + 1;
+        }
+    }
+    
+    TablaNombres *tabla = g_malloc(sizeof(TablaNombres) + sizeof(char*) * total + largo_texto);
+    tabla->num_nombres = total;
+    tabla->nombres = (const char**)(tabla + 1);
+    tabla->referencias = 1;
+    
+    char *texto = (char*)(tabla->nombres + total);
+    int idx = 0;
+    for (int g = 0; g < 4; g++) {
+        for (int i = 0; i < cantidades[g]; i++) {
+            int largo = g_snprintf(texto, 16, "%c%d", prefijos[g], i + 1);
+            tabla->nombres[idx++] = texto;
+            texto += largo + 1;
+        }
+    }
+    
+    return tabla;
+}
+
+TablaNombres* tabla_nombres_ref(TablaNombres *nombres) {
+    if (nombres) g_atomic_int_inc(&nombres->referencias);
+    return nombres;
+}
+
+void tabla_nombres_unref(TablaNombres *nombres) {
+    if (nombres && g_atomic_int_dec_and_test(&nombres->referencias)) {
+        g_free(nombres);
+    }
+}
+
 // Función para crear la tabla simplex
 TablaSimplex* crear_tabla_simplex(int num_vars, int num_rest, TipoProblema tipo) {
-    TablaSimplex *tabla = g_new0(TablaSimplex, 1);
+    Arena *arena = arena_nueva(0);
+    TablaSimplex *tabla = arena_new0(arena, TablaSimplex, 1);
+    tabla->arena = arena;
+    tabla->arena_propia = TRUE;
     tabla->num_vars_decision = num_vars;
     tabla->num_restricciones = num_rest;
     tabla->tipo = tipo;
     
-    tabla->tipos_restricciones = g_new0(TipoRestriccion, num_rest);
-    tabla->lados_derechos = g_new0(double, num_rest);
+    tabla->tipos_restricciones = arena_new0(arena, TipoRestriccion, num_rest);
+    tabla->lados_derechos = arena_new0(arena, double, num_rest);
     
     return tabla;
 }
 
-void establecer_funcion_objetivo(TablaSimplex *tabla, double *coeficientes) {
-    tabla->c = g_new0(double, tabla->num_vars_decision);
+void establecer_funcion_objetivo(TablaSimplex *tabla, const double *coeficientes) {
+    tabla->c = arena_new0(tabla->arena, double, tabla->num_vars_decision);
     for (int i = 0; i < tabla->num_vars_decision; i++) {
         tabla->c[i] = coeficientes[i];
     }
@@ -80,10 +127,10 @@ void establecer_funcion_objetivo(TablaSimplex *tabla, double *coeficientes) {
 void agregar_restriccion(TablaSimplex *tabla, int indice_rest, double *coeficientes, 
                         double lado_derecho, TipoRestriccion tipo) {
     if (!tabla->A) {
-        tabla->A = g_new0(double*, tabla->num_restricciones);
+        tabla->A = arena_new0(tabla->arena, double*, tabla->num_restricciones);
     }
     
-    tabla->A[indice_rest] = g_new0(double, tabla->num_vars_decision);
+    tabla->A[indice_rest] = arena_new0(tabla->arena, double, tabla->num_vars_decision);
     for (int i = 0; i < tabla->num_vars_decision; i++) {
         tabla->A[indice_rest][i] = coeficientes[i];
     }
@@ -92,7 +139,25 @@ void agregar_restriccion(TablaSimplex *tabla, int indice_rest, double *coeficien
     tabla->tipos_restricciones[indice_rest] = tipo;
 }
 
-void preparar_tabla_simplex(TablaSimplex *tabla) {
+// Igual que agregar_restriccion, pero con solo los coeficientes distintos de cero
+void agregar_restriccion_dispersa(TablaSimplex *tabla, int indice_rest, const guint32 *columnas,
+                                  const double *valores, int num_valores,
+                                  double lado_derecho, TipoRestriccion tipo) {
+    if (!tabla->A) {
+        tabla->A = arena_new0(tabla->arena, double*, tabla->num_restricciones);
+    }
+
+    tabla->A[indice_rest] = arena_new0(tabla->arena, double, tabla->num_vars_decision);
+    for (int k = 0; k < num_valores; k++) {
+        tabla->A[indice_rest][columnas[k]] = valores[k];
+    }
+
+    tabla->lados_derechos[indice_rest] = lado_derecho;
+    tabla->tipos_restricciones[indice_rest] = tipo;
+}
+
+// Cuenta las variables de holgura, exceso y artificiales y fija las dimensiones de la tabla
+static void contar_variables(TablaSimplex *tabla) {
     tabla->num_vars_holgura = 0;
     tabla->num_vars_exceso = 0;
     tabla->num_vars_artificiales = 0;
@@ -117,38 +182,15 @@ void preparar_tabla_simplex(TablaSimplex *tabla) {
     
     tabla->filas = tabla->num_restricciones + 1;
     tabla->columnas = total_vars + 1; 
+}
+
+// Llena la tabla inicial de la Gran M. Espera los arreglos ya reservados y en cero.
+static void llenar_tabla(TablaSimplex *tabla) {
+    int total_vars = tabla->columnas - 1;
     
-    tabla->tabla = g_new0(double*, tabla->filas);
-    for (int i = 0; i < tabla->filas; i++) {
-        tabla->tabla[i] = g_new0(double, tabla->columnas);
-    }
-    
-    tabla->nombres_vars = g_new0(char*, total_vars);
-    tabla->es_artificial = g_new0(int, total_vars);
-    
-    for (int i = 0; i < tabla->num_vars_decision; i++) {
-        tabla->nombres_vars[i] = g_strdup_printf("x%d", i + 1);
-        tabla->es_artificial[i] = 0;
-    }
-    
-    int idx = tabla->num_vars_decision;
-    
-    for (int i = 0; i < tabla->num_vars_holgura; i++) {
-        tabla->nombres_vars[idx] = g_strdup_printf("s%d", i + 1);
-        tabla->es_artificial[idx] = 0;
-        idx++;
-    }
-    
-    for (int i = 0; i < tabla->num_vars_exceso; i++) {
-        tabla->nombres_vars[idx] = g_strdup_printf("e%d", i + 1);
-        tabla->es_artificial[idx] = 0;
-        idx++;
-    }
-    
-    for (int i = 0; i < tabla->num_vars_artificiales; i++) {
-        tabla->nombres_vars[idx] = g_strdup_printf("a%d", i + 1);
-        tabla->es_artificial[idx] = 1;
-        idx++;
+    for (int i = tabla->num_vars_decision + tabla->num_vars_holgura + tabla->num_vars_exceso; 
+         i < total_vars; i++) {
+        tabla->es_artificial[i] = 1;
     }
     
     for (int j = 0; j < tabla->num_vars_decision; j++) {
@@ -160,7 +202,6 @@ void preparar_tabla_simplex(TablaSimplex *tabla) {
         tabla->tabla[0][j] = (tabla->tipo == MAXIMIZACION) ? -M_GRANDE : M_GRANDE;
     }
     
-    tabla->variables_base = g_new0(int, tabla->num_restricciones);
     int cont_holgura = 0, cont_exceso = 0, cont_artificial = 0;
     
     for (int i = 0; i < tabla->num_restricciones; i++) {
@@ -204,7 +245,6 @@ void preparar_tabla_simplex(TablaSimplex *tabla) {
     
     for (int i = 0; i < tabla->num_restricciones; i++) {
         if (tabla->es_artificial[tabla->variables_base[i]]) {
-            int var_base = tabla->variables_base[i];
             double factor = (tabla->tipo == MAXIMIZACION) ? M_GRANDE : -M_GRANDE;
             
             for (int j = 0; j <= total_vars; j++) {
@@ -214,19 +254,18 @@ void preparar_tabla_simplex(TablaSimplex *tabla) {
     }
 }
 
-// Encontrar columna pivote según el tipo de problema
-static int encontrar_columna_pivote(TablaSimplex *tabla) {
+// Encontrar columna pivote según el tipo de problema (solo entre las columnas no artificiales)
+static int encontrar_columna_pivote(TablaSimplex *tabla, const int *elegibles, int num_elegibles) {
+    const double *fila_z = tabla->tabla[0];
+    
     if (tabla->tipo == MAXIMIZACION) {
         double min_val = 0.0;
         int col_pivote = -1;
         
-        for (int j = 0; j < tabla->columnas - 1; j++) {
-            if (tabla->es_artificial[j]) {
-                continue;
-            }
-            
-            if (tabla->tabla[0][j] < min_val - EPSILON) {
-                min_val = tabla->tabla[0][j];
+        for (int k = 0; k < num_elegibles; k++) {
+            int j = elegibles[k];
+            if (fila_z[j] < min_val - EPSILON) {
+                min_val = fila_z[j];
                 col_pivote = j;
             }
         }
@@ -236,13 +275,10 @@ static int encontrar_columna_pivote(TablaSimplex *tabla) {
         double max_val = 0.0;
         int col_pivote = -1;
         
-        for (int j = 0; j < tabla->columnas - 1; j++) {
-            if (tabla->es_artificial[j]) {
-                continue;
-            }
-            
-            if (tabla->tabla[0][j] > max_val + EPSILON) {
-                max_val = tabla->tabla[0][j];
+        for (int k = 0; k < num_elegibles; k++) {
+            int j = elegibles[k];
+            if (fila_z[j] > max_val + EPSILON) {
+                max_val = fila_z[j];
                 col_pivote = j;
             }
         }
@@ -255,31 +291,37 @@ static int encontrar_columna_pivote(TablaSimplex *tabla) {
     }
 }
 
-// Encontrar fila pivote con detección de degeneración
-static int encontrar_fila_pivote(TablaSimplex *tabla, int col_pivote, gboolean *es_degenerado) {
+// Encontrar fila pivote con detección de degeneración.
+// Primero calcula todas las razones en el buffer y luego elige la menor.
+static int encontrar_fila_pivote(TablaSimplex *tabla, int col_pivote, double *razones, gboolean *es_degenerado) {
     double min_ratio = 1e15;
     int fila_pivote = -1;
     int cont_ceros = 0;
+    int col_b = tabla->columnas - 1;
     
     for (int i = 1; i < tabla->filas; i++) {
-        if (tabla->tabla[i][col_pivote] > EPSILON) {
-            double ratio = tabla->tabla[i][tabla->columnas - 1] / tabla->tabla[i][col_pivote];
-            
-            if (fabs(ratio) < EPSILON) {
-                cont_ceros++;
-            }
-            
-            if (ratio >= -EPSILON && ratio < min_ratio - EPSILON) {
-                min_ratio = ratio;
-                fila_pivote = i;
-            }
+        double elemento = tabla->tabla[i][col_pivote];
+        razones[i] = (elemento > EPSILON) ? tabla->tabla[i][col_b] / elemento : HUGE_VAL;
+    }
+    
+    for (int i = 1; i < tabla->filas; i++) {
+        double ratio = razones[i];
+        if (ratio == HUGE_VAL) continue;
+        
+        if (fabs(ratio) < EPSILON) {
+            cont_ceros++;
+        }
+        
+        if (ratio >= -EPSILON && ratio < min_ratio - EPSILON) {
+            min_ratio = ratio;
+            fila_pivote = i;
         }
     }
     
     if (es_degenerado) {
         *es_degenerado = (cont_ceros > 0);
         for (int i = 0; i < tabla->num_restricciones; i++) {
-            double valor_base = tabla->tabla[i + 1][tabla->columnas - 1];
+            double valor_base = tabla->tabla[i + 1][col_b];
             if (fabs(valor_base) < EPSILON) {
                 *es_degenerado = TRUE;
                 break;
@@ -309,16 +351,18 @@ static void realizar_pivote(TablaSimplex *tabla, int fila_pivote, int col_pivote
 }
 
 // Verificar optimalidad según tipo de problema
-static int verificar_optimalidad(TablaSimplex *tabla) {
+static int verificar_optimalidad(TablaSimplex *tabla, const int *elegibles, int num_elegibles) {
+    const double *fila_z = tabla->tabla[0];
+    
     if (tabla->tipo == MAXIMIZACION) {
-        for (int j = 0; j < tabla->columnas - 1; j++) {
-            if (!tabla->es_artificial[j] && tabla->tabla[0][j] < -EPSILON) {
+        for (int k = 0; k < num_elegibles; k++) {
+            if (fila_z[elegibles[k]] < -EPSILON) {
                 return 0; 
             }
         }
     } else {
-        for (int j = 0; j < tabla->columnas - 1; j++) {
-            if (!tabla->es_artificial[j] && tabla->tabla[0][j] > EPSILON) {
+        for (int k = 0; k < num_elegibles; k++) {
+            if (fila_z[elegibles[k]] > EPSILON) {
                 return 0; 
             }
         }
@@ -387,8 +431,8 @@ static int verificar_solucion_multiple(TablaSimplex *tabla) {
 }
 
 // Función para encontrar solución alternativa para múltiples soluciones
-static TablaSimplex* encontrar_solucion_alternativa(TablaSimplex *tabla_original) {
-    TablaSimplex *tabla = copiar_tabla(tabla_original);
+static TablaSimplex* encontrar_solucion_alternativa(Arena *arena, TablaSimplex *tabla_original) {
+    TablaSimplex *tabla = copiar_tabla(arena, tabla_original);
     int total_vars = tabla->num_vars_decision + tabla->num_vars_holgura + tabla->num_vars_exceso + tabla->num_vars_artificiales;
     
     for (int j = 0; j < total_vars; j++) {
@@ -421,7 +465,6 @@ static TablaSimplex* encontrar_solucion_alternativa(TablaSimplex *tabla_original
         }
     }
     
-    liberar_tabla_simplex(tabla);
     return NULL;
 }
 
@@ -439,77 +482,273 @@ void extraer_solucion(TablaSimplex *tabla, double *solucion) {
     }
 }
 
-// Función principal para resolver el simplex con todas las mejoras
-ResultadoSimplex* resolver_simplex(TablaSimplex *tabla, gboolean mostrar_tablas) {
-    ResultadoSimplex *resultado = g_new0(ResultadoSimplex, 1);
-    resultado->tablas_intermedias = g_new0(TablaSimplex*, MAX_ITERACIONES + 2);
+// Contexto reutilizable: buffers que crecen solo cuando llega un modelo más grande
+struct ContextoSimplex {
+    TablaSimplex trabajo;       // Tabla de trabajo; toma prestados c, A, b y tipos del modelo
+    
+    double *celdas;
+    gsize capacidad_celdas;
+    double **filas;
+    double *razones;
+    int *base;
+    int capacidad_filas;
+    
+    int *es_artificial;
+    int *elegibles;             // Columnas no artificiales candidatas a entrar
+    int capacidad_columnas;
+    
+    PivoteSimplex *pivotes;     // Registro de la resolución en curso (MAX_ITERACIONES)
+    
+    // Tabla de nombres de la última forma resuelta (decisión, holgura, exceso, artificiales)
+    TablaNombres *nombres;
+    int forma_nombres[4];
+    
+    Arena *arena_libre;         // Arena de un resultado reciclado, lista para reutilizarse
+    
+    ProgresoSimplexFunc progreso;
+    gpointer datos_progreso;
+    gint64 limite_tiempo;       // Microsegundos por resolución; 0 = sin límite
+    gint cancelado;             // Se lee y escribe de forma atómica (puede venir de otro hilo)
+};
+
+ContextoSimplex* contexto_simplex_nuevo(void) {
+    return g_new0(ContextoSimplex, 1);
+}
+
+void contexto_simplex_liberar(ContextoSimplex *ctx) {
+    if (!ctx) return;
+    
+    g_free(ctx->celdas);
+    g_free(ctx->filas);
+    g_free(ctx->razones);
+    g_free(ctx->base);
+    g_free(ctx->es_artificial);
+    g_free(ctx->elegibles);
+    g_free(ctx->pivotes);
+    tabla_nombres_unref(ctx->nombres);
+    arena_liberar(ctx->arena_libre);
+    g_free(ctx);
+}
+
+// Devuelve la memoria de un resultado al contexto para que la próxima resolución no reserve
+void contexto_simplex_reciclar_resultado(ContextoSimplex *ctx, ResultadoSimplex *resultado) {
+    if (!resultado) return;
+    
+    tabla_nombres_unref(resultado->nombres);
+    if (ctx->arena_libre) {
+        arena_liberar(ctx->arena_libre);
+    }
+    arena_reiniciar(resultado->arena);
+    ctx->arena_libre = resultado->arena;
+}
+
+// La función se llama al inicio de cada iteración, en el hilo que resuelve
+void contexto_simplex_establecer_progreso(ContextoSimplex *ctx, ProgresoSimplexFunc funcion, gpointer datos) {
+    ctx->progreso = funcion;
+    ctx->datos_progreso = datos;
+}
+
+// Tiempo máximo de cada resolución, contado desde que empieza; 0 lo desactiva
+void contexto_simplex_establecer_limite_tiempo(ContextoSimplex *ctx, gint64 microsegundos) {
+    ctx->limite_tiempo = MAX(microsegundos, 0);
+}
+
+// Pide detener la resolución en curso. Se puede llamar desde cualquier hilo;
+// el pedido queda activo hasta llamar a contexto_simplex_reanudar.
+void contexto_simplex_cancelar(ContextoSimplex *ctx) {
+    g_atomic_int_set(&ctx->cancelado, 1);
+}
+
+void contexto_simplex_reanudar(ContextoSimplex *ctx) {
+    g_atomic_int_set(&ctx->cancelado, 0);
+}
+
+// Suma de los valores de las variables artificiales básicas (0 si la base es factible)
+static double calcular_infactibilidad(TablaSimplex *tabla) {
+    double suma = 0.0;
+    for (int i = 0; i < tabla->num_restricciones; i++) {
+        if (tabla->es_artificial[tabla->variables_base[i]]) {
+            suma += fabs(tabla->tabla[i + 1][tabla->columnas - 1]);
+        }
+    }
+    return suma;
+}
+
+// Asegura que los buffers del contexto alcancen para la forma de la tabla de trabajo
+static void asegurar_capacidad(ContextoSimplex *ctx, int filas, int columnas) {
+    gsize celdas = (gsize)filas * columnas;
+    if (celdas > ctx->capacidad_celdas) {
+        ctx->celdas = g_renew(double, ctx->celdas, celdas);
+        ctx->capacidad_celdas = celdas;
+    }
+    
+    if (filas > ctx->capacidad_filas) {
+        ctx->filas = g_renew(double*, ctx->filas, filas);
+        ctx->razones = g_renew(double, ctx->razones, filas);
+        ctx->base = g_renew(int, ctx->base, filas);
+        ctx->capacidad_filas = filas;
+    }
+    
+    if (columnas > ctx->capacidad_columnas) {
+        ctx->es_artificial = g_renew(int, ctx->es_artificial, columnas);
+        ctx->elegibles = g_renew(int, ctx->elegibles, columnas);
+        ctx->capacidad_columnas = columnas;
+    }
+}
+
+// Reutiliza la tabla de nombres si el modelo tiene la misma forma que el anterior
+static TablaNombres* nombres_para_forma(ContextoSimplex *ctx, TablaSimplex *tabla) {
+    int forma[4] = { tabla->num_vars_decision, tabla->num_vars_holgura,
+                     tabla->num_vars_exceso, tabla->num_vars_artificiales };
+    
+    if (!ctx->nombres || memcmp(forma, ctx->forma_nombres, sizeof(forma)) != 0) {
+        tabla_nombres_unref(ctx->nombres);
+        ctx->nombres = tabla_nombres_nueva(forma[0], forma[1], forma[2], forma[3]);
+        memcpy(ctx->forma_nombres, forma, sizeof(forma));
+    }
+    return ctx->nombres;
+}
+
+// Prepara la tabla de trabajo del contexto a partir del modelo, sin reservar si ya hay capacidad
+static TablaSimplex* preparar_trabajo(ContextoSimplex *ctx, TablaSimplex *modelo) {
+    TablaSimplex *tabla = &ctx->trabajo;
+    memset(tabla, 0, sizeof(TablaSimplex));
+    tabla->num_vars_decision = modelo->num_vars_decision;
+    tabla->num_restricciones = modelo->num_restricciones;
+    tabla->tipo = modelo->tipo;
+    tabla->A = modelo->A;
+    tabla->c = modelo->c;
+    tabla->lados_derechos = modelo->lados_derechos;
+    tabla->tipos_restricciones = modelo->tipos_restricciones;
+    
+    contar_variables(tabla);
+    asegurar_capacidad(ctx, tabla->filas, tabla->columnas);
+    
+    memset(ctx->celdas, 0, sizeof(double) * (gsize)tabla->filas * tabla->columnas);
+    for (int i = 0; i < tabla->filas; i++) {
+        ctx->filas[i] = ctx->celdas + (gsize)i * tabla->columnas;
+    }
+    memset(ctx->es_artificial, 0, sizeof(int) * tabla->columnas);
+    
+    tabla->tabla = ctx->filas;
+    tabla->variables_base = ctx->base;
+    tabla->es_artificial = ctx->es_artificial;
+    tabla->nombres = nombres_para_forma(ctx, tabla);
+    
+    llenar_tabla(tabla);
+    return tabla;
+}
+
+// Resuelve el modelo usando los buffers del contexto. El modelo no se modifica.
+ResultadoSimplex* resolver_simplex_contexto(ContextoSimplex *ctx, TablaSimplex *modelo, gboolean mostrar_tablas) {
+    Arena *arena = ctx->arena_libre ? ctx->arena_libre : arena_nueva(0);
+    ctx->arena_libre = NULL;
+    
+    ResultadoSimplex *resultado = arena_new0(arena, ResultadoSimplex, 1);
+    resultado->arena = arena;
+    resultado->tablas_intermedias = arena_new0(arena, TablaSimplex*, MAX_ITERACIONES + 2);
     resultado->num_tablas = 0;
     resultado->es_degenerado = FALSE;
-    preparar_tabla_simplex(tabla);
-    resultado->tablas_intermedias[resultado->num_tablas++] = copiar_tabla(tabla);
+    TablaSimplex *tabla = preparar_trabajo(ctx, modelo);
+    resultado->nombres = tabla_nombres_ref(tabla->nombres);
+    resultado->tablas_intermedias[resultado->num_tablas++] = copiar_tabla(arena, tabla);
+    
+    int num_elegibles = 0;
+    for (int j = 0; j < tabla->columnas - 1; j++) {
+        if (!tabla->es_artificial[j]) {
+            ctx->elegibles[num_elegibles++] = j;
+        }
+    }
+    
+    if (!ctx->pivotes) {
+        ctx->pivotes = g_new(PivoteSimplex, MAX_ITERACIONES);
+    }
+    
     int iteracion = 0;
     gboolean problema_no_acotado = FALSE;
     gboolean problema_degenerado = FALSE;
+    gint64 fin = ctx->limite_tiempo > 0 ? g_get_monotonic_time() + ctx->limite_tiempo : 0;
     
     while (iteracion < MAX_ITERACIONES) {
-        if (verificar_optimalidad(tabla)) {
+        if (ctx->progreso) {
+            ProgresoSimplex progreso = {
+                .iteracion = iteracion,
+                .valor_z = tabla->tabla[0][tabla->columnas - 1],
+                .infactibilidad = calcular_infactibilidad(tabla)
+            };
+            ctx->progreso(&progreso, ctx->datos_progreso);
+        }
+        
+        if (g_atomic_int_get(&ctx->cancelado)) {
+            resultado->tipo_solucion = SOLUCION_INTERRUMPIDA;
+            resultado->mensaje = arena_strdup(arena, "Resolución cancelada");
+            break;
+        }
+        
+        if (fin && g_get_monotonic_time() >= fin) {
+            resultado->tipo_solucion = SOLUCION_INTERRUMPIDA;
+            resultado->mensaje = arena_strdup(arena, "Tiempo límite alcanzado");
+            break;
+        }
+        
+        if (verificar_optimalidad(tabla, ctx->elegibles, num_elegibles)) {
             if (!verificar_factibilidad(tabla)) {
                 resultado->tipo_solucion = SOLUCION_NO_FACTIBLE;
-                resultado->mensaje = g_strdup("El problema no tiene solución factible (variables artificiales en la base con valor positivo)");
+                resultado->mensaje = arena_strdup(arena, "El problema no tiene solución factible (variables artificiales en la base con valor positivo)");
                 break;
             }
             
             resultado->tipo_solucion = SOLUCION_OPTIMA;
             resultado->valor_z = tabla->tabla[0][tabla->columnas - 1];
-            resultado->solucion = g_new0(double, tabla->num_vars_decision);
+            resultado->solucion = arena_new0(arena, double, tabla->num_vars_decision);
             extraer_solucion(tabla, resultado->solucion);
             
             if (verificar_solucion_multiple(tabla)) {
                 resultado->tipo_solucion = SOLUCION_MULTIPLE;
-                resultado->mensaje = g_strdup("Solución óptima múltiple encontrada");
+                resultado->mensaje = arena_strdup(arena, "Solución óptima múltiple encontrada");
                 
-                TablaSimplex *tabla_alternativa = encontrar_solucion_alternativa(tabla);
+                TablaSimplex *tabla_alternativa = encontrar_solucion_alternativa(arena, tabla);
                 if (tabla_alternativa) {
                     resultado->segunda_tabla = tabla_alternativa;
                     
                     resultado->num_soluciones_adicionales = 1;
-                    resultado->soluciones_adicionales = g_new0(double*, 1);
-                    resultado->soluciones_adicionales[0] = g_new0(double, tabla->num_vars_decision);
+                    resultado->soluciones_adicionales = arena_new0(arena, double*, 1);
+                    resultado->soluciones_adicionales[0] = arena_new0(arena, double, tabla->num_vars_decision);
                     extraer_solucion(tabla_alternativa, resultado->soluciones_adicionales[0]);
                 }
             } else {
-                resultado->mensaje = g_strdup("Solución óptima única encontrada");
+                resultado->mensaje = arena_strdup(arena, "Solución óptima única encontrada");
             }
             
             if (problema_degenerado) {
                 resultado->es_degenerado = TRUE;
-                resultado->mensaje = g_strdup_printf("%s (problema degenerado)", resultado->mensaje);
+                resultado->mensaje = arena_strdup_printf(arena, "%s (problema degenerado)", resultado->mensaje);
             }
             
             break;
         }
         
-        int col_pivote = encontrar_columna_pivote(tabla);
+        int col_pivote = encontrar_columna_pivote(tabla, ctx->elegibles, num_elegibles);
         
         if (verificar_no_acotamiento(tabla, col_pivote)) {
             resultado->tipo_solucion = SOLUCION_NO_ACOTADA;
-            resultado->mensaje = g_strdup("El problema es no acotado");
+            resultado->mensaje = arena_strdup(arena, "El problema es no acotado");
             problema_no_acotado = TRUE;
             break;
         }
         
         if (col_pivote == -1) {
             resultado->tipo_solucion = SOLUCION_NO_ACOTADA;
-            resultado->mensaje = g_strdup("El problema es no acotado");
+            resultado->mensaje = arena_strdup(arena, "El problema es no acotado");
             break;
         }
         
         gboolean es_degenerado_iteracion = FALSE;
-        int fila_pivote = encontrar_fila_pivote(tabla, col_pivote, &es_degenerado_iteracion);
+        int fila_pivote = encontrar_fila_pivote(tabla, col_pivote, ctx->razones, &es_degenerado_iteracion);
         
         if (fila_pivote == -1) {
             resultado->tipo_solucion = SOLUCION_NO_ACOTADA;
-            resultado->mensaje = g_strdup("El problema es no acotado");
+            resultado->mensaje = arena_strdup(arena, "El problema es no acotado");
             break;
         }
         
@@ -518,24 +757,56 @@ ResultadoSimplex* resolver_simplex(TablaSimplex *tabla, gboolean mostrar_tablas)
         }
         
         if (mostrar_tablas) {
-            resultado->tablas_intermedias[resultado->num_tablas++] = copiar_tabla(tabla);
+            resultado->tablas_intermedias[resultado->num_tablas++] = copiar_tabla(arena, tabla);
         }
         
+        PivoteSimplex *pivote = &ctx->pivotes[iteracion];
+        pivote->columna = col_pivote;
+        pivote->fila = fila_pivote;
+        pivote->variable_sale = tabla->variables_base[fila_pivote - 1];
+        pivote->valor = tabla->tabla[fila_pivote][col_pivote];
+        
         realizar_pivote(tabla, fila_pivote, col_pivote);
+        pivote->valor_z = tabla->tabla[0][tabla->columnas - 1];
         iteracion++;
     }
     
+    if (resultado->tipo_solucion == SOLUCION_INTERRUMPIDA) {
+        resultado->valor_z = tabla->tabla[0][tabla->columnas - 1];
+    }
+    resultado->iteraciones = iteracion;
+    resultado->pivotes = arena_memdup(arena, ctx->pivotes, sizeof(PivoteSimplex) * iteracion);
+    
     if (iteracion >= MAX_ITERACIONES && !problema_no_acotado) {
         resultado->tipo_solucion = SOLUCION_NO_FACTIBLE;
-        resultado->mensaje = g_strdup("Número máximo de iteraciones alcanzado");
+        resultado->mensaje = arena_strdup(arena, "Número máximo de iteraciones alcanzado");
     }
     
     // Guardar tabla final
-    resultado->tablas_intermedias[resultado->num_tablas++] = copiar_tabla(tabla);
+    resultado->tablas_intermedias[resultado->num_tablas++] = copiar_tabla(arena, tabla);
     
     return resultado;
 }
 
+// Contexto que resolver_simplex usa en cada hilo: se crea en la primera resolución y se
+// libera al terminar el hilo, así que las siguientes ya no reservan buffers
+static GPrivate contexto_hilo = G_PRIVATE_INIT((GDestroyNotify)contexto_simplex_liberar);
+
+static ContextoSimplex* contexto_del_hilo(void) {
+    ContextoSimplex *ctx = g_private_get(&contexto_hilo);
+    if (!ctx) {
+        ctx = contexto_simplex_nuevo();
+        g_private_set(&contexto_hilo, ctx);
+    }
+    return ctx;
+}
+
+// Función principal para resolver el simplex con todas las mejoras. Igual que
+// resolver_simplex_contexto, la tabla recibida no se modifica.
+ResultadoSimplex* resolver_simplex(TablaSimplex *tabla, gboolean mostrar_tablas) {
+    return resolver_simplex_contexto(contexto_del_hilo(), tabla, mostrar_tablas);
+}
+
 ResultadoSimplex* ejecutar_simplex_completo(TablaSimplex *tabla, gboolean mostrar_tablas) {
     return resolver_simplex(tabla, mostrar_tablas);
 }
@@ -543,63 +814,25 @@ ResultadoSimplex* ejecutar_simplex_completo(TablaSimplex *tabla, gboolean mostra
 void liberar_tabla_simplex(TablaSimplex *tabla) {
     if (!tabla) return;
     
-    if (tabla->tabla) {
-        for (int i = 0; i < tabla->filas; i++) {
-            g_free(tabla->tabla[i]);
-        }
-        g_free(tabla->tabla);
-    }
-    
-    if (tabla->A) {
-        for (int i = 0; i < tabla->num_restricciones; i++) {
-            g_free(tabla->A[i]);
-        }
-        g_free(tabla->A);
-    }
-    
-    if (tabla->c) g_free(tabla->c);
-    if (tabla->variables_base) g_free(tabla->variables_base);
-    if (tabla->es_artificial) g_free(tabla->es_artificial);
-    if (tabla->lados_derechos) g_free(tabla->lados_derechos);
-    if (tabla->tipos_restricciones) g_free(tabla->tipos_restricciones);
-    
-    if (tabla->nombres_vars) {
-        int total_vars = tabla->num_vars_decision + tabla->num_vars_holgura + 
-                        tabla->num_vars_exceso + tabla->num_vars_artificiales;
-        for (int i = 0; i < total_vars; i++) {
-            g_free(tabla->nombres_vars[i]);
-        }
-        g_free(tabla->nombres_vars);
+    // Las copias guardadas en un resultado se liberan junto con la arena del resultado
+    if (tabla->arena_propia) {
+        tabla_nombres_unref(tabla->nombres);
+        arena_liberar(tabla->arena);
     }
-    
-    g_free(tabla);
 }
 
 void liberar_resultado(ResultadoSimplex *resultado) {
     if (!resultado) return;
     
-    if (resultado->solucion) g_free(resultado->solucion);
-    if (resultado->mensaje) g_free(resultado->mensaje);
-    
-    if (resultado->tablas_intermedias) {
-        for (int i = 0; i < resultado->num_tablas; i++) {
-            liberar_tabla_simplex(resultado->tablas_intermedias[i]);
-        }
-        g_free(resultado->tablas_intermedias);
+    // La solución, los mensajes y todas las tablas viven en la arena del resultado. Si
+    // este hilo ya resolvió con resolver_simplex, la arena queda para la próxima vez.
+    ContextoSimplex *ctx = g_private_get(&contexto_hilo);
+    if (ctx) {
+        contexto_simplex_reciclar_resultado(ctx, resultado);
+        return;
     }
-    
-    if (resultado->soluciones_adicionales) {
-        for (int i = 0; i < resultado->num_soluciones_adicionales; i++) {
-            g_free(resultado->soluciones_adicionales[i]);
-        }
-        g_free(resultado->soluciones_adicionales);
-    }
-    
-    if (resultado->segunda_tabla) {
-        liberar_tabla_simplex(resultado->segunda_tabla);
-    }
-    
-    g_free(resultado);
+    tabla_nombres_unref(resultado->nombres);
+    arena_liberar(resultado->arena);
 }
 
 const char* obtener_nombre_variable(TablaSimplex *tabla, int indice) {
@@ -607,5 +840,5 @@ const char* obtener_nombre_variable(TablaSimplex *tabla, int indice) {
                                 tabla->num_vars_exceso + tabla->num_vars_artificiales)) {
         return "?";
     }
-    return tabla->nombres_vars[indice];
+    return tabla->nombres->nombres[indice];
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define SIMPLEX_H
 
 #include <glib.h>
+#include "arena.h"
+
+G_BEGIN_DECLS
 
 typedef enum {
     MAXIMIZACION,
@@ -18,9 +21,23 @@ typedef enum {
     SOLUCION_OPTIMA,
     SOLUCION_MULTIPLE,
     SOLUCION_NO_ACOTADA,
-    SOLUCION_NO_FACTIBLE
+    SOLUCION_NO_FACTIBLE,
+    SOLUCION_INTERRUMPIDA   // Cancelada o fuera del tiempo límite
 } TipoSolucion;
 
+// Tabla inmutable de nombres de variables, compartida por todas las copias de una tabla.
+// Solo tienen una referencia propia las tablas creadas con crear_tabla_simplex (que la
+// sueltan en liberar_tabla_simplex) y cada ResultadoSimplex (que la suelta en
+// liberar_resultado). Las copias guardadas en un resultado (tablas_intermedias y
+// segunda_tabla) usan la del resultado sin sumar otra: sus nombres, igual que sus
+// arreglos, dejan de ser válidos al liberar o reciclar el resultado. Quien quiera
+// conservar los nombres más tiempo debe tomar su propia referencia con tabla_nombres_ref.
+typedef struct {
+    int num_nombres;
+    const char **nombres;   // Todos apuntan a un único bloque de texto
+    gint referencias;
+} TablaNombres;
+
 typedef struct {
     int filas;
     int columnas;
@@ -36,11 +53,24 @@ typedef struct {
     double *c;
     double *lados_derechos;
     int *variables_base;
-    char **nombres_vars;
+    TablaNombres *nombres;
     int *es_artificial;
     TipoRestriccion *tipos_restricciones;
+
+    Arena *arena;           // Dueña de todos los arreglos de la tabla
+    gboolean arena_propia;  // FALSE en las copias que pertenecen a un resultado: la arena y
+                            // los nombres son del resultado y liberar_tabla_simplex no los toca
 } TablaSimplex;
 
+// Un pivote del método: quién entra, quién sale y cómo queda Z
+typedef struct {
+    int columna;            // Variable que entra
+    int fila;               // Fila de la restricción (1..m; la 0 es Z)
+    int variable_sale;      // Variable que deja la base
+    double valor;           // Elemento pivote
+    double valor_z;         // Z después del pivote
+} PivoteSimplex;
+
 typedef struct {
     TipoSolucion tipo_solucion;
     double valor_z;
@@ -48,14 +78,33 @@ typedef struct {
     char *mensaje;
     TablaSimplex **tablas_intermedias;
     int num_tablas;
+    int iteraciones;
     gboolean es_degenerado;
     
     // Para soluciones múltiples
     double **soluciones_adicionales;
     int num_soluciones_adicionales;
     TablaSimplex *segunda_tabla;
+    TablaNombres *nombres;
+    
+    PivoteSimplex *pivotes;     // Uno por iteración, siempre (aun sin mostrar_tablas)
+
+    // Dueña de la solución, los mensajes y todas las tablas guardadas
+    Arena *arena;
 } ResultadoSimplex;
 
+// Contexto reutilizable entre resoluciones consecutivas (opaco)
+typedef struct ContextoSimplex ContextoSimplex;
+
+// Estado que se informa al inicio de cada iteración
+typedef struct {
+    int iteracion;
+    double valor_z;
+    double infactibilidad;  // Suma de las variables artificiales que siguen en la base
+} ProgresoSimplex;
+
+typedef void (*ProgresoSimplexFunc)(const ProgresoSimplex *progreso, gpointer datos);
+
 // Estructura para información del problema 
 typedef struct {
     const char *nombre_problema;
@@ -72,15 +121,33 @@ typedef struct {
 
 // Prototipos de funciones
 TablaSimplex* crear_tabla_simplex(int num_vars, int num_rest, TipoProblema tipo);
-void establecer_funcion_objetivo(TablaSimplex *tabla, double *coeficientes);
+void establecer_funcion_objetivo(TablaSimplex *tabla, const double *coeficientes);
 void agregar_restriccion(TablaSimplex *tabla, int indice_rest, double *coeficientes, 
                         double lado_derecho, TipoRestriccion tipo);
+void agregar_restriccion_dispersa(TablaSimplex *tabla, int indice_rest, const guint32 *columnas,
+                                  const double *valores, int num_valores,
+                                  double lado_derecho, TipoRestriccion tipo);
+// resolver_simplex y ejecutar_simplex_completo no modifican 'tabla': el método trabaja
+// sobre una copia en un ContextoSimplex propio de cada hilo, que se reutiliza entre
+// llamadas. Las tablas de cada iteración quedan en resultado->tablas_intermedias.
 ResultadoSimplex* resolver_simplex(TablaSimplex *tabla, gboolean mostrar_tablas);
 ResultadoSimplex* ejecutar_simplex_completo(TablaSimplex *tabla, gboolean mostrar_tablas);
 void liberar_tabla_simplex(TablaSimplex *tabla);
 void liberar_resultado(ResultadoSimplex *resultado);
 const char* obtener_nombre_variable(TablaSimplex *tabla, int indice);
+TablaNombres* tabla_nombres_nueva(int num_decision, int num_holgura, int num_exceso, int num_artificiales);
+TablaNombres* tabla_nombres_ref(TablaNombres *nombres);
+void tabla_nombres_unref(TablaNombres *nombres);
 void extraer_solucion(TablaSimplex *tabla, double *solucion);
-void preparar_tabla_simplex(TablaSimplex *tabla);
+ContextoSimplex* contexto_simplex_nuevo(void);
+void contexto_simplex_liberar(ContextoSimplex *ctx);
+ResultadoSimplex* resolver_simplex_contexto(ContextoSimplex *ctx, TablaSimplex *modelo, gboolean mostrar_tablas);
+void contexto_simplex_reciclar_resultado(ContextoSimplex *ctx, ResultadoSimplex *resultado);
+void contexto_simplex_establecer_progreso(ContextoSimplex *ctx, ProgresoSimplexFunc funcion, gpointer datos);
+void contexto_simplex_establecer_limite_tiempo(ContextoSimplex *ctx, gint64 microsegundos);
+void contexto_simplex_cancelar(ContextoSimplex *ctx);
+void contexto_simplex_reanudar(ContextoSimplex *ctx);
+
+G_END_DECLS
 
 #endif
\ No newline at end of file